@@ -0,0 +1,478 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "FileScriptCache.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <vector>
+#include "MappedFileBuffer.h"
+
+using namespace facebook;
+namespace fs = std::filesystem;
+
+namespace Microsoft::NodeApiJsi {
+
+namespace {
+
+constexpr uint32_t CacheFileMagic = 0x43534a4e; // "NJSC"
+constexpr uint32_t CacheFileFormatVersion = 1;
+constexpr size_t PayloadAlignment = 16;
+constexpr char CacheFileExtension[] = ".jsc";
+constexpr char TempFileExtension[] = ".tmp";
+
+// Temporary files left by crashed writers are removed after this time.
+constexpr std::chrono::hours TempFileLifetime{1};
+
+// The cache file starts with the header. It is followed by the serialized key and the aligned payload.
+struct CacheFileHeader {
+  uint32_t magic;
+  uint32_t formatVersion;
+  uint64_t keyHash;
+  uint64_t keySize;
+  uint64_t payloadOffset;
+  uint64_t payloadSize;
+  uint64_t payloadHash;
+};
+
+enum class CacheFileStatus {
+  Valid,
+  OtherKey,
+  Corrupted,
+};
+
+#ifdef _WIN32
+
+// The cache file content read into memory aligned to the payload alignment.
+// Windows cannot replace a file while it has a mapped view. The cache files are read instead of mapped to let
+// the store replace them while the loaded data is still in use.
+class CacheFileContent : public jsi::Buffer {
+ public:
+  explicit CacheFileContent(size_t size) : blocks_((size + PayloadAlignment - 1) / PayloadAlignment), size_(size) {}
+
+  size_t size() const override {
+    return size_;
+  }
+
+  const uint8_t *data() const override {
+    return blocks_.empty() ? nullptr : blocks_.front().bytes;
+  }
+
+  char *mutableData() noexcept {
+    return reinterpret_cast<char *>(blocks_.data());
+  }
+
+ private:
+  struct Block {
+    alignas(PayloadAlignment) uint8_t bytes[PayloadAlignment];
+  };
+
+  std::vector<Block> blocks_;
+  size_t size_;
+};
+
+#endif
+
+// Returns the cache file content or nullptr if the file cannot be read.
+// The file can be removed or replaced by another process at any time.
+std::unique_ptr<jsi::Buffer> readCacheFile(const fs::path &path) {
+  std::error_code ec;
+  if (!fs::is_regular_file(path, ec)) {
+    return nullptr;
+  }
+#ifdef _WIN32
+  std::ifstream stream(path, std::ios::binary | std::ios::ate);
+  std::streamoff size = stream.tellg();
+  if (!stream || size < 0) {
+    return nullptr;
+  }
+  auto content = std::make_unique<CacheFileContent>(static_cast<size_t>(size));
+  stream.seekg(0);
+  if (!stream.read(content->mutableData(), size)) {
+    return nullptr;
+  }
+  return content;
+#else
+  try {
+    return std::make_unique<MappedFileBuffer>(path.string());
+  } catch (const jsi::JSIException &) {
+    return nullptr;
+  }
+#endif
+}
+
+// Exposes the payload of a cache file.
+class CacheFileBuffer : public jsi::Buffer {
+ public:
+  CacheFileBuffer(std::unique_ptr<jsi::Buffer> file, size_t offset, size_t size) noexcept
+      : file_(std::move(file)), offset_(offset), size_(size) {}
+
+  size_t size() const override {
+    return size_;
+  }
+
+  const uint8_t *data() const override {
+    return file_->data() + offset_;
+  }
+
+ private:
+  std::unique_ptr<jsi::Buffer> file_;
+  size_t offset_;
+  size_t size_;
+};
+
+void appendUInt64(std::string &result, uint64_t value) {
+  result.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void appendString(std::string &result, std::string_view value) {
+  appendUInt64(result, value.size());
+  result.append(value);
+}
+
+// Serializes the key fields with their lengths to make the result unambiguous.
+std::string serializeKey(const ScriptCacheKey &key) {
+  std::string result;
+  result.reserve(key.sourceURL.size() + key.runtimeName.size() + key.tag.size() + 5 * sizeof(uint64_t));
+  appendString(result, key.sourceURL);
+  appendUInt64(result, key.sourceHash);
+  appendString(result, key.runtimeName);
+  appendUInt64(result, key.runtimeVersion);
+  appendString(result, key.tag);
+  return result;
+}
+
+std::string toHex(uint64_t value) {
+  std::string result(16, '0');
+  for (size_t i = result.size(); i > 0 && value != 0; --i, value >>= 4) {
+    result[i - 1] = "0123456789abcdef"[value & 0xF];
+  }
+  return result;
+}
+
+CacheFileStatus checkCacheFile(const jsi::Buffer &file, uint64_t keyHash, std::string_view keyData) noexcept {
+  CacheFileHeader header{};
+  if (file.size() < sizeof(header)) {
+    return CacheFileStatus::Corrupted;
+  }
+  std::memcpy(&header, file.data(), sizeof(header));
+  uint64_t fileSize = file.size();
+  if (header.magic != CacheFileMagic || header.formatVersion != CacheFileFormatVersion ||
+      header.keyHash != keyHash || header.keySize > fileSize - sizeof(header) ||
+      header.payloadOffset < sizeof(header) + header.keySize || header.payloadOffset > fileSize ||
+      header.payloadSize != fileSize - header.payloadOffset) {
+    return CacheFileStatus::Corrupted;
+  }
+  std::string_view fileKeyData(reinterpret_cast<const char *>(file.data()) + sizeof(header), header.keySize);
+  if (fileKeyData != keyData) {
+    return CacheFileStatus::OtherKey;
+  }
+  if (FileScriptCache::hash(file.data() + header.payloadOffset, header.payloadSize) != header.payloadHash) {
+    return CacheFileStatus::Corrupted;
+  }
+  return CacheFileStatus::Valid;
+}
+
+} // namespace
+
+FileScriptCache::FileScriptCache(fs::path directory, uint64_t maxSizeInBytes)
+    : directory_(std::move(directory)),
+      maxSizeInBytes_(maxSizeInBytes),
+      tempFileSuffix_((static_cast<uint64_t>(std::random_device{}()) << 32) | std::random_device{}()) {}
+
+std::shared_ptr<const jsi::Buffer> FileScriptCache::load(const ScriptCacheKey &key) noexcept {
+  try {
+    std::string keyData = serializeKey(key);
+    uint64_t keyHash = hash(reinterpret_cast<const uint8_t *>(keyData.data()), keyData.size());
+    fs::path path = getFilePath(keyHash);
+    std::error_code ec;
+    std::unique_ptr<jsi::Buffer> file = readCacheFile(path);
+    CacheFileStatus status = file ? checkCacheFile(*file, keyHash, keyData) : CacheFileStatus::OtherKey;
+    if (status != CacheFileStatus::Valid) {
+      file.reset();
+      if (status == CacheFileStatus::Corrupted) {
+        fs::remove(path, ec);
+      }
+      std::scoped_lock lock{mutex_};
+      ++stats_.missCount;
+      stats_.corruptionCount += status == CacheFileStatus::Corrupted ? 1 : 0;
+      return nullptr;
+    }
+
+    // The file modification time is the last use time for the LRU eviction.
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+    CacheFileHeader header{};
+    std::memcpy(&header, file->data(), sizeof(header));
+    {
+      std::scoped_lock lock{mutex_};
+      ++stats_.hitCount;
+    }
+    return std::make_shared<CacheFileBuffer>(
+        std::move(file), static_cast<size_t>(header.payloadOffset), static_cast<size_t>(header.payloadSize));
+  } catch (...) {
+    std::scoped_lock lock{mutex_};
+    ++stats_.missCount;
+    return nullptr;
+  }
+}
+
+bool FileScriptCache::store(const ScriptCacheKey &key, const uint8_t *data, size_t size) noexcept {
+  try {
+    std::string keyData = serializeKey(key);
+    CacheFileHeader header{};
+    header.magic = CacheFileMagic;
+    header.formatVersion = CacheFileFormatVersion;
+    header.keyHash = hash(reinterpret_cast<const uint8_t *>(keyData.data()), keyData.size());
+    header.keySize = keyData.size();
+    header.payloadOffset = (sizeof(header) + keyData.size() + PayloadAlignment - 1) & ~(PayloadAlignment - 1);
+    header.payloadSize = size;
+    header.payloadHash = hash(data, size);
+    if (header.payloadOffset + size > maxSizeInBytes_) {
+      return false;
+    }
+
+    std::error_code ec;
+    fs::create_directories(directory_, ec);
+    fs::path path = getFilePath(header.keyHash);
+    fs::path tempPath = path;
+    {
+      std::scoped_lock lock{mutex_};
+      tempPath += "." + toHex(tempFileSuffix_ + tempFileCount_++) + TempFileExtension;
+    }
+
+    // Readers never see partially written files because the complete file is renamed to the cache file name.
+    bool isWritten{};
+    {
+      std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+      const char padding[PayloadAlignment]{};
+      stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+      stream.write(keyData.data(), keyData.size());
+      stream.write(padding, header.payloadOffset - sizeof(header) - keyData.size());
+      stream.write(reinterpret_cast<const char *>(data), size);
+      stream.close();
+      isWritten = !stream.fail();
+    }
+    if (isWritten) {
+      fs::rename(tempPath, path, ec);
+    }
+    if (!isWritten || ec) {
+      fs::remove(tempPath, ec);
+      return false;
+    }
+
+    std::scoped_lock lock{mutex_};
+    ++stats_.storeCount;
+    evictFiles(path);
+    return true;
+  } catch (...) {
+    return false;
+  }
+}
+
+void FileScriptCache::clear() noexcept {
+  std::scoped_lock lock{mutex_};
+  std::error_code ec;
+  for (fs::directory_iterator it(directory_, ec), end; !ec && it != end; it.increment(ec)) {
+    fs::path extension = it->path().extension();
+    if (extension == CacheFileExtension || extension == TempFileExtension) {
+      std::error_code removeError;
+      fs::remove(it->path(), removeError);
+    }
+  }
+}
+
+FileScriptCacheStats FileScriptCache::getStats() noexcept {
+  std::scoped_lock lock{mutex_};
+  return stats_;
+}
+
+// The XXH64 hash function. It is fast enough to verify the payload on every load.
+uint64_t FileScriptCache::hash(const uint8_t *data, size_t size, uint64_t seed) noexcept {
+  constexpr uint64_t Prime1 = 0x9e3779b185ebca87ull;
+  constexpr uint64_t Prime2 = 0xc2b2ae3d27d4eb4full;
+  constexpr uint64_t Prime3 = 0x165667b19e3779f9ull;
+  constexpr uint64_t Prime4 = 0x85ebca77c2b2ae63ull;
+  constexpr uint64_t Prime5 = 0x27d4eb2f165667c5ull;
+  auto rotateLeft = [](uint64_t value, int bits) { return (value << bits) | (value >> (64 - bits)); };
+  auto read64 = [](const uint8_t *p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+  };
+  auto round = [&](uint64_t acc, uint64_t input) { return rotateLeft(acc + input * Prime2, 31) * Prime1; };
+  auto merge = [&](uint64_t acc, uint64_t value) { return (acc ^ round(0, value)) * Prime1 + Prime4; };
+
+  const uint8_t *p = data;
+  const uint8_t *end = data + size;
+  uint64_t result{};
+  if (size >= 32) {
+    uint64_t v1 = seed + Prime1 + Prime2;
+    uint64_t v2 = seed + Prime2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - Prime1;
+    for (; end - p >= 32; p += 32) {
+      v1 = round(v1, read64(p));
+      v2 = round(v2, read64(p + 8));
+      v3 = round(v3, read64(p + 16));
+      v4 = round(v4, read64(p + 24));
+    }
+    result = rotateLeft(v1, 1) + rotateLeft(v2, 7) + rotateLeft(v3, 12) + rotateLeft(v4, 18);
+    result = merge(merge(merge(merge(result, v1), v2), v3), v4);
+  } else {
+    result = seed + Prime5;
+  }
+
+  result += size;
+  for (; end - p >= 8; p += 8) {
+    result = rotateLeft(result ^ round(0, read64(p)), 27) * Prime1 + Prime4;
+  }
+  if (end - p >= 4) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    result = rotateLeft(result ^ (value * Prime1), 23) * Prime2 + Prime3;
+    p += 4;
+  }
+  for (; p < end; ++p) {
+    result = rotateLeft(result ^ (*p * Prime5), 11) * Prime1;
+  }
+
+  result ^= result >> 33;
+  result *= Prime2;
+  result ^= result >> 29;
+  result *= Prime3;
+  result ^= result >> 32;
+  return result;
+}
+
+fs::path FileScriptCache::getFilePath(uint64_t keyHash) const {
+  return directory_ / (toHex(keyHash) + CacheFileExtension);
+}
+
+// Removes the least recently used files until the total size fits the limit. It must be called under the mutex.
+void FileScriptCache::evictFiles(const fs::path &keepPath) {
+  struct CacheFile {
+    fs::path path;
+    uint64_t size;
+    fs::file_time_type lastUseTime;
+  };
+
+  std::vector<CacheFile> files;
+  uint64_t totalSize{};
+  fs::file_time_type now = fs::file_time_type::clock::now();
+  std::error_code ec;
+  for (fs::directory_iterator it(directory_, ec), end; !ec && it != end; it.increment(ec)) {
+    std::error_code fileError;
+    fs::file_time_type lastUseTime = it->last_write_time(fileError);
+    uint64_t size = it->file_size(fileError);
+    if (fileError) {
+      continue;
+    }
+    fs::path extension = it->path().extension();
+    if (extension == TempFileExtension && now - lastUseTime > TempFileLifetime) {
+      fs::remove(it->path(), fileError);
+    } else if (extension == CacheFileExtension) {
+      files.push_back(CacheFile{it->path(), size, lastUseTime});
+      totalSize += size;
+    }
+  }
+
+  if (totalSize <= maxSizeInBytes_) {
+    return;
+  }
+  std::sort(files.begin(), files.end(), [](const CacheFile &left, const CacheFile &right) {
+    return left.lastUseTime < right.lastUseTime;
+  });
+  for (const CacheFile &file : files) {
+    if (totalSize <= maxSizeInBytes_) {
+      break;
+    }
+    if (file.path != keepPath && fs::remove(file.path, ec)) {
+      totalSize -= file.size;
+      ++stats_.evictionCount;
+    }
+  }
+}
+
+//=====================================================================================================================
+// Hermes script cache adapter
+//=====================================================================================================================
+
+namespace {
+
+std::string_view toStringView(const char *value) noexcept {
+  return value ? std::string_view(value) : std::string_view();
+}
+
+ScriptCacheKey toScriptCacheKey(const hermes_script_cache_metadata &metadata) noexcept {
+  return ScriptCacheKey{
+      toStringView(metadata.source_url),
+      metadata.source_hash,
+      toStringView(metadata.runtime_name),
+      metadata.runtime_version,
+      toStringView(metadata.tag)};
+}
+
+FileScriptCache &getFileScriptCache(hermes_script_cache scriptCache) noexcept {
+  return **reinterpret_cast<std::shared_ptr<FileScriptCache> *>(scriptCache);
+}
+
+void NAPI_CDECL loadHermesScript(
+    hermes_script_cache scriptCache,
+    hermes_script_cache_metadata *scriptMetadata,
+    const uint8_t **buffer,
+    size_t *bufferSize,
+    hermes_data_delete_cb *bufferDeleteCallback,
+    void **deleterData) {
+  std::shared_ptr<const jsi::Buffer> data = getFileScriptCache(scriptCache).load(toScriptCacheKey(*scriptMetadata));
+  if (!data) {
+    *buffer = nullptr;
+    *bufferSize = 0;
+    *bufferDeleteCallback = nullptr;
+    *deleterData = nullptr;
+    return;
+  }
+  *buffer = data->data();
+  *bufferSize = data->size();
+  *bufferDeleteCallback = [](void * /*data*/, void *deleterData) {
+    delete reinterpret_cast<std::shared_ptr<const jsi::Buffer> *>(deleterData);
+  };
+  *deleterData = new std::shared_ptr<const jsi::Buffer>(std::move(data));
+}
+
+void NAPI_CDECL storeHermesScript(
+    hermes_script_cache scriptCache,
+    hermes_script_cache_metadata *scriptMetadata,
+    const uint8_t *buffer,
+    size_t bufferSize,
+    hermes_data_delete_cb bufferDeleteCallback,
+    void *deleterData) {
+  getFileScriptCache(scriptCache).store(toScriptCacheKey(*scriptMetadata), buffer, bufferSize);
+  if (bufferDeleteCallback) {
+    bufferDeleteCallback(const_cast<uint8_t *>(buffer), deleterData);
+  }
+}
+
+void NAPI_CDECL deleteHermesScriptCache(void *scriptCache, void * /*deleterData*/) {
+  delete reinterpret_cast<std::shared_ptr<FileScriptCache> *>(scriptCache);
+}
+
+} // namespace
+
+napi_status setHermesScriptCache(HermesApi *hermesApi, hermes_config config, std::shared_ptr<FileScriptCache> cache) {
+  auto scriptCache = std::make_unique<std::shared_ptr<FileScriptCache>>(std::move(cache));
+  napi_status status = hermesApi->hermes_config_set_script_cache(
+      config,
+      reinterpret_cast<hermes_script_cache>(scriptCache.get()),
+      loadHermesScript,
+      storeHermesScript,
+      deleteHermesScriptCache,
+      nullptr);
+  if (status == napi_ok) {
+    scriptCache.release();
+  }
+  return status;
+}
+
+} // namespace Microsoft::NodeApiJsi
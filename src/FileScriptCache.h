@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+#ifndef SRC_FILESCRIPTCACHE_H_
+#define SRC_FILESCRIPTCACHE_H_
+
+#include <jsi/jsi.h>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include "HermesApi.h"
+
+namespace Microsoft::NodeApiJsi {
+
+// Identifies a compiled script in the cache.
+// The source hash is the hash of the script source content. The runtime name, version, and tag identify
+// the compiled data format.
+struct ScriptCacheKey {
+  std::string_view sourceURL;
+  uint64_t sourceHash{};
+  std::string_view runtimeName;
+  uint64_t runtimeVersion{};
+  std::string_view tag;
+};
+
+// Counters of the file script cache.
+struct FileScriptCacheStats {
+  uint64_t hitCount;
+  uint64_t missCount;
+  uint64_t storeCount;
+  uint64_t evictionCount;
+  uint64_t corruptionCount;
+};
+
+// Stores compiled scripts as files in a directory.
+// - File names are derived from the key hash and each file has the full key to detect hash collisions.
+// - Files are written to a temporary file first and then renamed to replace the previous version atomically.
+// - The payload hash is verified on load. Corrupted files are removed.
+// - The total size of the files is kept under the limit by removing the least recently loaded or stored files.
+// The cache can be used from multiple threads and by multiple processes that share the directory.
+class FileScriptCache {
+ public:
+  FileScriptCache(std::filesystem::path directory, uint64_t maxSizeInBytes);
+
+  // Returns the cached data for the key or nullptr if it is not found or corrupted.
+  std::shared_ptr<const facebook::jsi::Buffer> load(const ScriptCacheKey &key) noexcept;
+
+  // Stores the data for the key. Returns false if the data is larger than the cache size limit or cannot be written.
+  bool store(const ScriptCacheKey &key, const uint8_t *data, size_t size) noexcept;
+
+  // Removes all cache files.
+  void clear() noexcept;
+
+  FileScriptCacheStats getStats() noexcept;
+
+  const std::filesystem::path &directory() const noexcept {
+    return directory_;
+  }
+
+  // Computes the 64-bit hash that the cache uses for keys and payload integrity checks.
+  static uint64_t hash(const uint8_t *data, size_t size, uint64_t seed = 0) noexcept;
+
+ private:
+  std::filesystem::path getFilePath(uint64_t keyHash) const;
+  void evictFiles(const std::filesystem::path &keepPath);
+
+ private:
+  std::mutex mutex_;
+  const std::filesystem::path directory_;
+  const uint64_t maxSizeInBytes_;
+  const uint64_t tempFileSuffix_;
+  uint64_t tempFileCount_{};
+  FileScriptCacheStats stats_{};
+};
+
+// Makes the Hermes runtimes created with the config load compiled scripts from the cache and store them there.
+// The prepareJavaScript and evaluateJavaScript of the runtimes use the cache through the Hermes config.
+napi_status setHermesScriptCache(HermesApi *hermesApi, hermes_config config, std::shared_ptr<FileScriptCache> cache);
+
+} // namespace Microsoft::NodeApiJsi
+
+#endif // !SRC_FILESCRIPTCACHE_H_
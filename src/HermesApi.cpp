@@ -5,23 +5,59 @@
 
 namespace Microsoft::NodeApiJsi {
 
+thread_local HermesApi *HermesApi::current_{};
+
+const std::vector<const char *> &HermesApi::funcNames() {
+  static const std::vector<const char *> names = []() {
+    std::vector<const char *> result = NodeApi::funcNames();
+#define HERMES_FUNC(func) result.push_back(#func);
+#include "HermesFunctions.inc"
+#undef HERMES_FUNC
+    return result;
+  }();
+  return names;
+}
+
+#ifdef NODE_API_JSI_STATIC_LINK
+
+HermesApi::HermesApi(IFuncResolver *funcResolver, ApiBindingMode bindingMode) : NodeApi(funcResolver, bindingMode) {}
+
+HermesApi *HermesApi::fromLib() {
+  static HermesApi *libHermesApi = new HermesApi(nullptr, ApiBindingMode::Eager);
+  return libHermesApi;
+}
+
+#else
+
 namespace {
 
 struct HermesNames {
 #define HERMES_FUNC(func) static constexpr const char func[] = #func;
 #include "HermesFunctions.inc"
+#undef HERMES_FUNC
 };
 
 } // namespace
 
-thread_local HermesApi *HermesApi::current_{};
-
-HermesApi::HermesApi(IFuncResolver *funcResolver)
-    : NodeApi(funcResolver)
+HermesApi::HermesApi(IFuncResolver *funcResolver, ApiBindingMode bindingMode)
+    : NodeApi(funcResolver, bindingMode)
 #define HERMES_FUNC(func) \
   , func(&ApiFuncResolver<NodeApi, decltype(::func) *, HermesNames::func, offsetof(HermesApi, func)>::stub)
 #include "HermesFunctions.inc"
+#undef HERMES_FUNC
 {
+  if (bindingMode != ApiBindingMode::Eager) {
+    return;
+  }
+
+#define HERMES_FUNC(func)                                                                                              \
+  if (auto loaded = reinterpret_cast<decltype(::func) *>(getFuncPtr(HermesNames::func))) {                             \
+    const_cast<decltype(::func) *&>(this->func) = loaded;                                                              \
+  } else {                                                                                                             \
+    missingFuncs_.push_back(HermesNames::func);                                                                        \
+  }
+#include "HermesFunctions.inc"
+#undef HERMES_FUNC
 }
 
 HermesApi *HermesApi::fromLib() {
@@ -30,4 +66,6 @@ HermesApi *HermesApi::fromLib() {
   return libHermesApi;
 }
 
+#endif // NODE_API_JSI_STATIC_LINK
+
 } // namespace Microsoft::NodeApiJsi
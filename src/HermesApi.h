@@ -12,7 +12,7 @@ namespace Microsoft::NodeApiJsi {
 
 class HermesApi : public NodeApi {
  public:
-  HermesApi(IFuncResolver *funcResolver);
+  HermesApi(IFuncResolver *funcResolver, ApiBindingMode bindingMode = ApiBindingMode::Lazy);
 
   static HermesApi *current() noexcept {
     return current_;
@@ -23,6 +23,9 @@ class HermesApi : public NodeApi {
     current_ = current;
   }
 
+  // Names of all functions in the NodeApi and HermesApi function tables.
+  static const std::vector<const char *> &funcNames();
+
   static HermesApi *fromLib();
 
   class Scope : public NodeApi::Scope {
@@ -41,8 +44,13 @@ class HermesApi : public NodeApi {
     HermesApi *prevHermesApi_;
   };
 
+#ifdef NODE_API_JSI_STATIC_LINK
+#define HERMES_FUNC(func) static constexpr decltype(::func) &func = ::func;
+#else
 #define HERMES_FUNC(func) decltype(::func) *const func;
+#endif
 #include "HermesFunctions.inc"
+#undef HERMES_FUNC
 
  private:
   static thread_local HermesApi *current_;
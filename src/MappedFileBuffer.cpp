@@ -0,0 +1,233 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "MappedFileBuffer.h"
+#include <chrono>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+using namespace facebook;
+
+namespace Microsoft::NodeApiJsi {
+
+namespace {
+
+[[noreturn]] void throwMappingError(const char *action, const std::string &path, const std::string &reason) {
+  throw jsi::JSINativeException(std::string("Could not ") + action + " file " + path + ": " + reason);
+}
+
+// Reads one byte from each page to fault in the pages that the OS did not populate.
+[[maybe_unused]] void touchPages(const uint8_t *data, size_t size, size_t pageSize) noexcept {
+  volatile uint8_t sink{};
+  for (size_t offset = 0; offset < size; offset += pageSize) {
+    sink = sink + data[offset];
+  }
+}
+
+} // namespace
+
+#ifdef _WIN32
+
+PageFaultCounts getPageFaultCounts() noexcept {
+  PROCESS_MEMORY_COUNTERS counters{};
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return {};
+  }
+  return PageFaultCounts{counters.PageFaultCount, 0};
+}
+
+MappedFileBuffer::MappedFileBuffer(const std::string &path, const MappedFileOptions &options) {
+  PageFaultCounts startPageFaults = getPageFaultCounts();
+  auto startTime = std::chrono::steady_clock::now();
+
+  DWORD flags = options.sequentialAccess ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL;
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throwMappingError("open", path, "error " + std::to_string(GetLastError()));
+  }
+  LARGE_INTEGER fileSize{};
+  if (!GetFileSizeEx(file, &fileSize)) {
+    DWORD error = GetLastError();
+    CloseHandle(file);
+    throwMappingError("get size of", path, "error " + std::to_string(error));
+  }
+  size_ = static_cast<size_t>(fileSize.QuadPart);
+
+  // Empty files cannot be mapped. They are represented by an empty buffer.
+  if (size_ > 0) {
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    DWORD error = GetLastError();
+    CloseHandle(file);
+    if (mapping == nullptr) {
+      throwMappingError("map", path, "error " + std::to_string(error));
+    }
+    // The view keeps the file mapping alive after the handle is closed.
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    error = GetLastError();
+    CloseHandle(mapping);
+    if (view == nullptr) {
+      throwMappingError("map", path, "error " + std::to_string(error));
+    }
+    data_ = static_cast<const uint8_t *>(view);
+
+    // Windows does not support large pages for file views. The hugePages option is ignored.
+    if (options.willNeed || options.populate) {
+      WIN32_MEMORY_RANGE_ENTRY range{view, size_};
+      PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+    if (options.populate) {
+      SYSTEM_INFO systemInfo{};
+      GetSystemInfo(&systemInfo);
+      touchPages(data_, size_, systemInfo.dwPageSize);
+    }
+  } else {
+    CloseHandle(file);
+  }
+
+  PageFaultCounts endPageFaults = getPageFaultCounts();
+  loadStats_.loadMicroseconds =
+      std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+  loadStats_.pageFaults.pageFaultCount = endPageFaults.pageFaultCount - startPageFaults.pageFaultCount;
+}
+
+MappedFileBuffer::~MappedFileBuffer() {
+  if (data_ != nullptr) {
+    UnmapViewOfFile(data_);
+  }
+}
+
+#else
+
+namespace {
+
+// Huge pages of the file mappings are 2 MB on the platforms that support them.
+constexpr size_t HugePageSize = 2 * 1024 * 1024;
+
+size_t alignUp(size_t value, size_t alignment) noexcept {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Reserves an address range aligned to the huge page size for the mapping.
+// Returns nullptr if the range cannot be reserved.
+void *reserveHugePageAlignedRange(size_t size, size_t pageSize) noexcept {
+  size_t reservedSize = alignUp(size, pageSize) + HugePageSize;
+  void *reserved = ::mmap(nullptr, reservedSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (reserved == MAP_FAILED) {
+    return nullptr;
+  }
+  // Release the unused parts before and after the aligned range.
+  uintptr_t start = reinterpret_cast<uintptr_t>(reserved);
+  uintptr_t alignedStart = alignUp(start, HugePageSize);
+  uintptr_t alignedEnd = alignedStart + alignUp(size, pageSize);
+  if (alignedStart > start) {
+    ::munmap(reserved, alignedStart - start);
+  }
+  if (start + reservedSize > alignedEnd) {
+    ::munmap(reinterpret_cast<void *>(alignedEnd), start + reservedSize - alignedEnd);
+  }
+  return reinterpret_cast<void *>(alignedStart);
+}
+
+} // namespace
+
+PageFaultCounts getPageFaultCounts() noexcept {
+  rusage usage{};
+  if (::getrusage(RUSAGE_SELF, &usage) != 0) {
+    return {};
+  }
+  return PageFaultCounts{
+      static_cast<uint64_t>(usage.ru_minflt) + static_cast<uint64_t>(usage.ru_majflt),
+      static_cast<uint64_t>(usage.ru_majflt)};
+}
+
+MappedFileBuffer::MappedFileBuffer(const std::string &path, const MappedFileOptions &options) {
+  PageFaultCounts startPageFaults = getPageFaultCounts();
+  auto startTime = std::chrono::steady_clock::now();
+
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    throwMappingError("open", path, std::strerror(errno));
+  }
+  struct stat fileStat {};
+  if (::fstat(fd, &fileStat) != 0) {
+    int error = errno;
+    ::close(fd);
+    throwMappingError("get size of", path, std::strerror(error));
+  }
+  size_ = static_cast<size_t>(fileStat.st_size);
+
+  // Empty files cannot be mapped. They are represented by an empty buffer.
+  if (size_ > 0) {
+    size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    if (options.populate) {
+      flags |= MAP_POPULATE;
+    }
+#endif
+    void *address = options.hugePages ? reserveHugePageAlignedRange(size_, pageSize) : nullptr;
+    if (address != nullptr) {
+      flags |= MAP_FIXED;
+    }
+    void *mapping = ::mmap(address, size_, PROT_READ, flags, fd, 0);
+    int error = errno;
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+      if (address != nullptr) {
+        ::munmap(address, size_);
+      }
+      throwMappingError("map", path, std::strerror(error));
+    }
+    data_ = static_cast<const uint8_t *>(mapping);
+
+    // The advice is only a hint. Its failures do not prevent the file use.
+#ifdef MADV_HUGEPAGE
+    if (options.hugePages) {
+      ::madvise(mapping, size_, MADV_HUGEPAGE);
+    }
+#endif
+    if (options.sequentialAccess) {
+      ::madvise(mapping, size_, MADV_SEQUENTIAL);
+    }
+    if (options.willNeed) {
+      ::madvise(mapping, size_, MADV_WILLNEED);
+    }
+#ifndef MAP_POPULATE
+    if (options.populate) {
+      touchPages(data_, size_, pageSize);
+    }
+#endif
+  } else {
+    ::close(fd);
+  }
+
+  PageFaultCounts endPageFaults = getPageFaultCounts();
+  loadStats_.loadMicroseconds =
+      std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+  loadStats_.pageFaults.pageFaultCount = endPageFaults.pageFaultCount - startPageFaults.pageFaultCount;
+  loadStats_.pageFaults.majorPageFaultCount =
+      endPageFaults.majorPageFaultCount - startPageFaults.majorPageFaultCount;
+}
+
+MappedFileBuffer::~MappedFileBuffer() {
+  if (data_ != nullptr) {
+    ::munmap(const_cast<uint8_t *>(data_), size_);
+  }
+}
+
+#endif
+
+} // namespace Microsoft::NodeApiJsi
@@ -0,0 +1,77 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+#ifndef SRC_MAPPEDFILEBUFFER_H_
+#define SRC_MAPPEDFILEBUFFER_H_
+
+#include <jsi/jsi.h>
+#include <cstdint>
+#include <string>
+
+namespace Microsoft::NodeApiJsi {
+
+// Options for mapping script source or bytecode bundle files into memory.
+struct MappedFileOptions {
+  // Hints the OS that the file is read front to back, so that it reads ahead more aggressively.
+  bool sequentialAccess{true};
+  // Starts reading the whole file into the page cache without waiting for the reads to complete.
+  bool willNeed{true};
+  // Reads the whole file and creates the page table entries before the constructor returns.
+  // It removes the page faults from the script loading at the cost of a longer mapping time.
+  bool populate{false};
+  // Aligns the mapping to the huge page size and asks the OS to back it with huge pages.
+  // It is only a hint: Linux uses huge pages for read-only file mappings if the kernel supports it.
+  bool hugePages{false};
+};
+
+// Page fault counters of the current process.
+// The pageFaultCount includes all page faults. The majorPageFaultCount includes only the page faults that had
+// to read from the disk. It is zero on platforms that do not report it.
+struct PageFaultCounts {
+  uint64_t pageFaultCount;
+  uint64_t majorPageFaultCount;
+};
+
+// Returns the page fault counters of the current process.
+// The difference between two calls gives the page faults caused by the code between them.
+PageFaultCounts getPageFaultCounts() noexcept;
+
+// Counters collected while the file was opened and mapped.
+struct MappedFileLoadStats {
+  double loadMicroseconds;
+  PageFaultCounts pageFaults;
+};
+
+// Read-only memory-mapped file that is passed to prepareJavaScript and evaluateJavaScript without copying.
+// The JS engines read the bytecode directly from the mapping and reference the ASCII source text from it.
+class MappedFileBuffer : public facebook::jsi::Buffer {
+ public:
+  // Throws jsi::JSINativeException if the file cannot be opened or mapped.
+  explicit MappedFileBuffer(const std::string &path, const MappedFileOptions &options = {});
+  ~MappedFileBuffer() override;
+
+  MappedFileBuffer(const MappedFileBuffer &) = delete;
+  MappedFileBuffer &operator=(const MappedFileBuffer &) = delete;
+
+  size_t size() const override {
+    return size_;
+  }
+
+  const uint8_t *data() const override {
+    return data_;
+  }
+
+  const MappedFileLoadStats &loadStats() const noexcept {
+    return loadStats_;
+  }
+
+ private:
+  const uint8_t *data_{};
+  size_t size_{};
+  MappedFileLoadStats loadStats_{};
+};
+
+} // namespace Microsoft::NodeApiJsi
+
+#endif // !SRC_MAPPEDFILEBUFFER_H_
@@ -2,35 +2,35 @@
 // Licensed under the MIT License.
 
 #include "NodeApi.h"
+#include <cstring>
 
-EXTERN_C_START
-
-extern napi_status NAPI_CDECL default_napi_ext_get_description(napi_env env, char *buf, size_t bufsize, size_t *result);
-
-extern napi_status NAPI_CDECL default_napi_ext_drain_microtasks(napi_env env, int32_t max_count_hint, bool *result);
-
-extern napi_status NAPI_CDECL default_napi_ext_is_inspectable(napi_env env, bool *result);
-
-extern napi_status NAPI_CDECL default_napi_ext_create_prepared_script(
-    napi_env env,
-    uint8_t *script_data,
-    size_t script_length,
-    napi_finalize finalize_cb,
-    void *finalize_hint,
-    const char *source_url,
-    napi_ext_prepared_script *result);
-
-extern napi_status NAPI_CDECL
-default_napi_ext_delete_prepared_script(napi_env env, napi_ext_prepared_script prepared_script);
+namespace Microsoft::NodeApiJsi {
 
-extern napi_status NAPI_CDECL
-default_napi_ext_prepared_script_run(napi_env env, napi_ext_prepared_script prepared_script, napi_value *result);
+namespace {
 
-EXTERN_C_END
+#ifdef NODE_API_JSI_STATIC_LINK
+
+// Resolves the names of the functions that are bound to the linked JS engine at compile time.
+// The optional functions that use the default implementations are not found.
+class StaticFuncResolver : public IFuncResolver {
+ public:
+  FuncPtr getFuncPtr(const char *funcName) override {
+#define NODE_API_FUNC(func)                  \
+  if (std::strcmp(funcName, #func) == 0) {   \
+    return reinterpret_cast<FuncPtr>(&::func); \
+  }
+#ifdef NODE_API_JSI_STATIC_LINK_EXT
+#define NODE_API_EXT_FUNC NODE_API_FUNC
+#endif
+#define NODE_API_PREPARED_SCRIPT NODE_API_FUNC
+#include "NodeApiFunctions.inc"
+    return nullptr;
+  }
+};
 
-namespace Microsoft::NodeApiJsi {
+StaticFuncResolver staticFuncResolver;
 
-namespace {
+#else
 
 struct NodeApiNames {
 #define NODE_API_FUNC(func) static constexpr const char func[] = #func;
@@ -40,23 +40,52 @@ struct NodeApiNames {
 };
 
 // Prepared script function either should be all loaded or we use all default functions.
-void loadPreparedScriptFuncs() {
-  NodeApi *current = NodeApi::current();
+void loadPreparedScriptFuncs(NodeApi *current) {
   bool useDefault = false;
 #define NODE_API_PREPARED_SCRIPT(func)                                                                         \
   decltype(func) *loaded_##func = reinterpret_cast<decltype(func) *>(current->getFuncPtr(NodeApiNames::func)); \
   useDefault = useDefault || loaded_##func == nullptr;
 #include "NodeApiFunctions.inc"
 #define NODE_API_PREPARED_SCRIPT(func) \
-  const_cast<decltype(func) *>(current->func) = useDefault ? &default_##func : loaded_##func;
+  const_cast<decltype(func) *&>(current->func) = useDefault ? &default_##func : loaded_##func;
 #include "NodeApiFunctions.inc"
 }
 
+void loadCurrentPreparedScriptFuncs() {
+  loadPreparedScriptFuncs(NodeApi::current());
+}
+
+#endif // NODE_API_JSI_STATIC_LINK
+
 } // namespace
 
-LibFuncResolver::LibFuncResolver(const char *libName) : libHandle_(LibLoader::loadLib(libName)) {}
+LibFuncResolver::LibFuncResolver(const char *libName, const LibLoadOptions &options)
+    : libHandle_(LibLoader::loadLib(libName, options)) {}
+
+LibFuncResolver::LibFuncResolver(
+    const char *libName,
+    const LibLoadOptions &options,
+    const std::vector<const char *> &funcNames)
+    : LibFuncResolver(libName, options) {
+  if (libHandle_ == nullptr) {
+    return;
+  }
+  prefetchedFuncs_.reserve(funcNames.size());
+  for (const char *funcName : funcNames) {
+    prefetchedFuncs_.try_emplace(funcName, LibLoader::getFuncPtr(libHandle_, funcName));
+  }
+}
 
 FuncPtr LibFuncResolver::getFuncPtr(const char *funcName) {
+  if (libHandle_ == nullptr) {
+    return nullptr;
+  }
+  if (!prefetchedFuncs_.empty()) {
+    auto it = prefetchedFuncs_.find(funcName);
+    if (it != prefetchedFuncs_.end()) {
+      return it->second;
+    }
+  }
   return LibLoader::getFuncPtr(libHandle_, funcName);
 }
 
@@ -70,8 +99,26 @@ FuncPtr DelayLoadedApi::getFuncPtr(const char *funcName) {
 
 thread_local NodeApi *NodeApi::current_{};
 
-NodeApi::NodeApi(IFuncResolver *funcResolver)
-    : DelayLoadedApi(funcResolver)
+const std::vector<const char *> &NodeApi::funcNames() {
+  static const std::vector<const char *> names{
+#define NODE_API_FUNC(func) #func,
+#define NODE_API_EXT_FUNC NODE_API_FUNC
+#define NODE_API_PREPARED_SCRIPT NODE_API_FUNC
+#include "NodeApiFunctions.inc"
+  };
+  return names;
+}
+
+#ifdef NODE_API_JSI_STATIC_LINK
+
+NodeApi::NodeApi(IFuncResolver * /*funcResolver*/, ApiBindingMode bindingMode)
+    : DelayLoadedApi(&staticFuncResolver), bindingMode_(bindingMode) {}
+
+#else
+
+NodeApi::NodeApi(IFuncResolver *funcResolver, ApiBindingMode bindingMode)
+    : DelayLoadedApi(funcResolver),
+      bindingMode_(bindingMode)
 #define NODE_API_FUNC(func) \
   , func(&ApiFuncResolver<NodeApi, decltype(::func) *, NodeApiNames::func, offsetof(NodeApi, func)>::stub)
 #define NODE_API_EXT_FUNC(func)                                                                                      \
@@ -81,9 +128,30 @@ NodeApi::NodeApi(IFuncResolver *funcResolver)
 #define NODE_API_PREPARED_SCRIPT(func)                                                                              \
   ,                                                                                                                 \
       func(&ApiFuncResolver<NodeApi, decltype(::func) *, NodeApiNames::func, offsetof(NodeApi, func)>::preloadStub< \
-           &loadPreparedScriptFuncs>)
+           &loadCurrentPreparedScriptFuncs>)
 #include "NodeApiFunctions.inc"
 {
+  if (bindingMode != ApiBindingMode::Eager) {
+    return;
+  }
+
+  // The required functions that are not found keep the stub to fail the same way as the lazy binding.
+#define NODE_API_FUNC(func)                                                                                            \
+  if (auto loaded = reinterpret_cast<decltype(::func) *>(getFuncPtr(NodeApiNames::func))) {                            \
+    const_cast<decltype(::func) *&>(this->func) = loaded;                                                              \
+  } else {                                                                                                             \
+    missingFuncs_.push_back(NodeApiNames::func);                                                                       \
+  }
+#define NODE_API_EXT_FUNC(func)                                                                                        \
+  if (auto loaded = reinterpret_cast<decltype(::func) *>(getFuncPtr(NodeApiNames::func))) {                            \
+    const_cast<decltype(::func) *&>(this->func) = loaded;                                                              \
+  } else {                                                                                                             \
+    const_cast<decltype(::func) *&>(this->func) = &default_##func;                                                     \
+  }
+#include "NodeApiFunctions.inc"
+  loadPreparedScriptFuncs(this);
 }
 
+#endif // NODE_API_JSI_STATIC_LINK
+
 } // namespace Microsoft::NodeApiJsi
@@ -6,15 +6,173 @@
 #define SRC_NODEAPI_H_
 
 #include <napi/js_native_ext_api.h>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+EXTERN_C_START
+
+// Optional Node-API extensions that are not declared in the js_native_ext_api.h.
+// The NodeApi uses their default implementations if a JS engine does not provide them.
+
+// Gets the value type along with the boolean or number value in one call.
+// The bool_value, double_value, and string_length are optional and only set for the matching value types.
+// The string_length is the length of the string in UTF-8 code units.
+NAPI_EXTERN napi_status NAPI_CDECL napi_ext_get_type_and_value(
+    napi_env env,
+    napi_value value,
+    napi_valuetype *result_type,
+    bool *bool_value,
+    double *double_value,
+    size_t *string_length);
+
+// Gets count array elements starting from the index.
+NAPI_EXTERN napi_status NAPI_CDECL
+napi_ext_get_elements(napi_env env, napi_value array, uint32_t index, uint32_t count, napi_value *result);
+
+// Sets count array elements starting from the index.
+NAPI_EXTERN napi_status NAPI_CDECL
+napi_ext_set_elements(napi_env env, napi_value array, uint32_t index, uint32_t count, const napi_value *values);
+
+#ifndef NODE_API_EXPERIMENTAL_HAS_EXTERNAL_STRINGS
+// Creates a string that references the external Latin-1 characters without copying them if the engine supports it.
+// If the copied is set to true, then the finalize_callback was already called.
+NAPI_EXTERN napi_status NAPI_CDECL node_api_create_external_string_latin1(
+    napi_env env,
+    char *str,
+    size_t length,
+    napi_finalize finalize_callback,
+    void *finalize_hint,
+    napi_value *result,
+    bool *copied);
+
+// Creates a string that references the external UTF-16 characters without copying them if the engine supports it.
+// If the copied is set to true, then the finalize_callback was already called.
+NAPI_EXTERN napi_status NAPI_CDECL node_api_create_external_string_utf16(
+    napi_env env,
+    char16_t *str,
+    size_t length,
+    napi_finalize finalize_callback,
+    void *finalize_hint,
+    napi_value *result,
+    bool *copied);
+#endif // !NODE_API_EXPERIMENTAL_HAS_EXTERNAL_STRINGS
+
+// A script compiled by napi_ext_compile_script.
+typedef struct napi_ext_compiled_script__ *napi_ext_compiled_script;
+
+// Compiles the script without a napi_env. It can be called from any thread.
+// The script data is only used during the call. Compilation errors are reported when the prepared script is created.
+// Returns napi_generic_failure if the engine cannot compile scripts outside of the JS thread.
+NAPI_EXTERN napi_status NAPI_CDECL napi_ext_compile_script(
+    const uint8_t *script_data,
+    size_t script_length,
+    const char *source_url,
+    napi_ext_compiled_script *result);
+
+// Creates a prepared script from the compiled script on the JS thread. It deletes the compiled script.
+NAPI_EXTERN napi_status NAPI_CDECL napi_ext_create_prepared_script_from_compiled(
+    napi_env env,
+    napi_ext_compiled_script compiled_script,
+    napi_ext_prepared_script *result);
+
+// Deletes the compiled script that is not used to create a prepared script. It can be called from any thread.
+NAPI_EXTERN napi_status NAPI_CDECL napi_ext_delete_compiled_script(napi_ext_compiled_script compiled_script);
+
+// The default implementations of the optional functions that are used if a JS engine does not provide them.
+// Some of them call other functions through the NodeApi::current() that must be set by a NodeApi::Scope.
+
+napi_status NAPI_CDECL default_napi_ext_get_description(napi_env env, char *buf, size_t bufsize, size_t *result);
+
+napi_status NAPI_CDECL default_napi_ext_drain_microtasks(napi_env env, int32_t max_count_hint, bool *result);
+
+napi_status NAPI_CDECL default_napi_ext_is_inspectable(napi_env env, bool *result);
+
+napi_status NAPI_CDECL default_napi_ext_get_type_and_value(
+    napi_env env,
+    napi_value value,
+    napi_valuetype *result_type,
+    bool *bool_value,
+    double *double_value,
+    size_t *string_length);
+
+napi_status NAPI_CDECL
+default_napi_ext_get_elements(napi_env env, napi_value array, uint32_t index, uint32_t count, napi_value *result);
+
+napi_status NAPI_CDECL
+default_napi_ext_set_elements(napi_env env, napi_value array, uint32_t index, uint32_t count, const napi_value *values);
+
+napi_status NAPI_CDECL default_node_api_create_external_string_latin1(
+    napi_env env,
+    char *str,
+    size_t length,
+    napi_finalize finalize_callback,
+    void *finalize_hint,
+    napi_value *result,
+    bool *copied);
+
+napi_status NAPI_CDECL default_node_api_create_external_string_utf16(
+    napi_env env,
+    char16_t *str,
+    size_t length,
+    napi_finalize finalize_callback,
+    void *finalize_hint,
+    napi_value *result,
+    bool *copied);
+
+napi_status NAPI_CDECL default_napi_ext_compile_script(
+    const uint8_t *script_data,
+    size_t script_length,
+    const char *source_url,
+    napi_ext_compiled_script *result);
+
+napi_status NAPI_CDECL default_napi_ext_create_prepared_script_from_compiled(
+    napi_env env,
+    napi_ext_compiled_script compiled_script,
+    napi_ext_prepared_script *result);
+
+napi_status NAPI_CDECL default_napi_ext_delete_compiled_script(napi_ext_compiled_script compiled_script);
+
+napi_status NAPI_CDECL default_napi_ext_create_prepared_script(
+    napi_env env,
+    uint8_t *script_data,
+    size_t script_length,
+    napi_finalize finalize_cb,
+    void *finalize_hint,
+    const char *source_url,
+    napi_ext_prepared_script *result);
+
+napi_status NAPI_CDECL
+default_napi_ext_delete_prepared_script(napi_env env, napi_ext_prepared_script prepared_script);
+
+napi_status NAPI_CDECL
+default_napi_ext_prepared_script_run(napi_env env, napi_ext_prepared_script prepared_script, napi_value *result);
+
+
+EXTERN_C_END
 
 namespace Microsoft::NodeApiJsi {
 
 using LibHandle = struct LibHandle_t *;
 using FuncPtr = struct FuncPtr_t *;
 
+// Options for loading the JS engine library.
+struct LibLoadOptions {
+  // Resolves all symbol references of the library when it is loaded instead of on their first use.
+  // It maps to RTLD_NOW vs RTLD_LAZY on POSIX and is ignored on Windows that always binds on load.
+  bool bindNow{false};
+  // Directories that are searched in order before the default OS library search.
+  // Relative directories are resolved against the current directory.
+  std::vector<std::string> searchPaths;
+};
+
 class LibLoader {
  public:
-  static LibHandle loadLib(const char *libName);
+  // The libName without a path and extension is the base name such as "hermes". It is mapped to the
+  // platform file name: hermes.dll, libhermes.so, or libhermes.dylib.
+  // Returns nullptr if the library is not found.
+  static LibHandle loadLib(const char *libName, const LibLoadOptions &options = {});
   static FuncPtr getFuncPtr(LibHandle libHandle, const char *funcName);
 };
 
@@ -67,11 +225,21 @@ struct IFuncResolver {
 
 class LibFuncResolver : public IFuncResolver {
  public:
-  LibFuncResolver(const char *libName);
+  LibFuncResolver(const char *libName, const LibLoadOptions &options = {});
+
+  // Resolves the functions when the library is loaded and caches them including the missing ones.
+  // It moves the symbol lookup cost to the startup. The funcNames must be static strings.
+  LibFuncResolver(const char *libName, const LibLoadOptions &options, const std::vector<const char *> &funcNames);
+
   FuncPtr getFuncPtr(const char *funcName) override;
 
+  LibHandle libHandle() const noexcept {
+    return libHandle_;
+  }
+
  private:
   LibHandle libHandle_;
+  std::unordered_map<std::string_view, FuncPtr> prefetchedFuncs_;
 };
 
 class DelayLoadedApi {
@@ -88,9 +256,34 @@ class DelayLoadedApi {
   IFuncResolver *funcResolver_;
 };
 
+// Defines when the API function table is bound to the JS engine library functions.
+enum class ApiBindingMode {
+  // Each function is resolved on its first call using the API set by the Scope on the calling thread.
+  Lazy,
+  // All functions are resolved by the constructor. The calls of the JS engine functions do not use the
+  // thread-local current API. The optional functions that the JS engine does not provide are bound to their
+  // default_* implementations that still use the current API, and they must be called inside of a Scope.
+  // The NodeApiJsiRuntime calls the default implementations directly with its NodeApi instead.
+  // The required functions that are not found are reported by the missingFuncs.
+  Eager,
+};
+
 class NodeApi : public DelayLoadedApi {
  public:
-  NodeApi(IFuncResolver *funcResolver);
+  NodeApi(IFuncResolver *funcResolver, ApiBindingMode bindingMode = ApiBindingMode::Lazy);
+
+  ApiBindingMode bindingMode() const noexcept {
+    return bindingMode_;
+  }
+
+  // Names of the required functions that were not found by the eager binding.
+  // It is always empty for the lazy binding.
+  const std::vector<const char *> &missingFuncs() const noexcept {
+    return missingFuncs_;
+  }
+
+  // Names of all functions in the NodeApi function table.
+  static const std::vector<const char *> &funcNames();
 
   static NodeApi *current() {
     return current_;
@@ -114,12 +307,30 @@ class NodeApi : public DelayLoadedApi {
     NodeApi *prevNodeApi_;
   };
 
+ private:
+  const ApiBindingMode bindingMode_;
+
  public:
+#ifdef NODE_API_JSI_STATIC_LINK
+  // The functions are bound at compile time to the directly linked JS engine library.
+  // The calls through the NodeApi instance are direct calls that the link-time optimization can inline.
+  // The optional functions use the default implementations unless NODE_API_JSI_STATIC_LINK_EXT is defined.
+#define NODE_API_FUNC(func) static constexpr decltype(::func) &func = ::func;
+#ifdef NODE_API_JSI_STATIC_LINK_EXT
+#define NODE_API_EXT_FUNC NODE_API_FUNC
+#else
+#define NODE_API_EXT_FUNC(func) static constexpr decltype(::func) &func = ::default_##func;
+#endif
+#else
 #define NODE_API_FUNC(func) decltype(::func) *const func;
 #define NODE_API_EXT_FUNC NODE_API_FUNC
+#endif
 #define NODE_API_PREPARED_SCRIPT NODE_API_FUNC
 #include "NodeApiFunctions.inc"
 
+ protected:
+  std::vector<const char *> missingFuncs_;
+
  private:
   static thread_local NodeApi *current_;
 };
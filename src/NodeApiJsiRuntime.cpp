@@ -4,12 +4,21 @@
 #define NAPI_EXPERIMENTAL
 
 #include "NodeApiJsiRuntime.h"
+#include "NodeApiProfiler.h"
+#include "NodeApiScriptCompiler.h"
 
 #include <algorithm>
 #include <array>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <list>
 #include <optional>
 #include <sstream>
 #include <string_view>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -63,10 +72,21 @@ using namespace std::string_view_literals;
     }                                               \
   } while (false)
 
+// Attributes the N-API calls made by the enclosing JSI method or callback to it while a NodeApiProfiler is active.
+#define PROFILE_JSI_METHOD() NodeApiProfiler::JsiMethodScope profilerMethodScope_(__func__)
+
 #ifdef __cpp_lib_span
 #include <span>
 #endif // __cpp_lib_span
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#endif
+
 namespace Microsoft::NodeApiJsi {
 
 namespace {
@@ -111,6 +131,69 @@ class span {
 };
 #endif // __cpp_lib_span
 
+// Returns true if the string has only ASCII characters.
+// Such UTF-8 strings are created as Latin-1 strings that engines do not need to decode.
+bool isAscii(const char *data, size_t length) noexcept;
+
+// The default implementations of the optional Node-API functions for the JS engines that do not provide them.
+// They use the NodeApi passed as the first parameter instead of the thread-local NodeApi::current().
+// The runtime calls them directly for the missing functions, and the default_* functions in the NodeApi
+// function table call them with the NodeApi::current().
+struct NodeApiDefaults {
+  static napi_status getElements(
+      NodeApi *nodeApi,
+      napi_env env,
+      napi_value array,
+      uint32_t index,
+      uint32_t count,
+      napi_value *result);
+  static napi_status setElements(
+      NodeApi *nodeApi,
+      napi_env env,
+      napi_value array,
+      uint32_t index,
+      uint32_t count,
+      const napi_value *values);
+  static napi_status createExternalStringLatin1(
+      NodeApi *nodeApi,
+      napi_env env,
+      char *str,
+      size_t length,
+      napi_finalize finalizeCallback,
+      void *finalizeHint,
+      napi_value *result,
+      bool *copied);
+  static napi_status createExternalStringUtf16(
+      NodeApi *nodeApi,
+      napi_env env,
+      char16_t *str,
+      size_t length,
+      napi_finalize finalizeCallback,
+      void *finalizeHint,
+      napi_value *result,
+      bool *copied);
+  // The hasExternalStringLatin1 is false if the default createExternalStringLatin1 must be used.
+  static napi_status createPreparedScript(
+      NodeApi *nodeApi,
+      bool hasExternalStringLatin1,
+      napi_env env,
+      uint8_t *scriptData,
+      size_t scriptLength,
+      napi_finalize finalizeCallback,
+      void *finalizeHint,
+      const char *sourceURL,
+      napi_ext_prepared_script *result);
+  static napi_status deletePreparedScript(NodeApi *nodeApi, napi_env env, napi_ext_prepared_script preparedScript);
+  // The functionConstructor is the Function used to compile the expression scripts.
+  // The global Function is used if it is nullptr.
+  static napi_status runPreparedScript(
+      NodeApi *nodeApi,
+      napi_env env,
+      napi_ext_prepared_script preparedScript,
+      napi_value functionConstructor,
+      napi_value *result);
+};
+
 // To be used as a key in a unordered_map.
 class StringKey {
  public:
@@ -151,13 +234,36 @@ class StringKey {
 };
 
 // Implementation of N-API JSI Runtime
-class NodeApiJsiRuntime : public jsi::Runtime {
+class NodeApiJsiRuntime : public jsi::Runtime, public INodeApiJsiRuntime {
  public:
   NodeApiJsiRuntime(napi_env env, NodeApi *nodeApi, std::function<void()> onDelete) noexcept;
   ~NodeApiJsiRuntime() override;
 
   jsi::Value evaluateJavaScript(const std::shared_ptr<const jsi::Buffer> &buffer, const std::string &sourceURL)
       override;
+  const jsi::PropNameID *getCachedPropNameIDs(const char *const *names, size_t count) override;
+  void getUtf8(const jsi::String &str, void *context, Utf8Callback callback) override;
+  void getUtf8(const jsi::PropNameID &name, void *context, Utf8Callback callback) override;
+  size_t copyUtf8(const jsi::String &str, char *buffer, size_t bufferSize) override;
+  size_t copyUtf8(const jsi::PropNameID &name, char *buffer, size_t bufferSize) override;
+  jsi::String createExternalStringFromUtf8(const std::shared_ptr<const jsi::Buffer> &buffer) override;
+  jsi::String createExternalStringFromUtf16(const std::shared_ptr<const jsi::Buffer> &buffer) override;
+  jsi::String createStringFromUtf16(const char16_t *utf16, size_t length) override;
+  std::u16string utf16(const jsi::String &str) override;
+  void enableStringInternCache(size_t maxEntryCount, size_t maxStringLength) override;
+  StringInternCacheStats getStringInternCacheStats() override;
+  void enablePreparedScriptCache(size_t maxEntryCount) override;
+  PreparedScriptCacheStats getPreparedScriptCacheStats() override;
+  void prepareJavaScriptAsync(
+      const std::shared_ptr<const jsi::Buffer> &buffer,
+      std::string sourceURL,
+      JSThreadDispatcher dispatcher,
+      PrepareJavaScriptCallback callback) override;
+  JsiResult tryCall(const jsi::Function &func, const jsi::Value &jsThis, const jsi::Value *args, size_t count) override;
+  JsiResult tryGetProperty(const jsi::Object &obj, const jsi::PropNameID &name) override;
+  JsiResult tryEvaluate(const std::shared_ptr<const jsi::Buffer> &buffer, const std::string &sourceURL) override;
+  jsi::BigInt createBigIntFromWords(bool isNegative, const uint64_t *words, size_t wordCount) override;
+  size_t getBigIntWords(const jsi::BigInt &bigint, bool *isNegative, uint64_t *words, size_t wordCapacity) override;
   std::shared_ptr<const jsi::PreparedJavaScript> prepareJavaScript(
       const std::shared_ptr<const jsi::Buffer> &buffer,
       std::string sourceURL) override;
@@ -167,6 +273,19 @@ class NodeApiJsiRuntime : public jsi::Runtime {
   std::string description() override;
   bool isInspectable() override;
 
+  void defineLazyProperty(const jsi::Object &obj, const jsi::PropNameID &name, LazyValueFactory factory) override;
+  void getValuesAtIndex(const jsi::Array &arr, size_t index, jsi::Value *values, size_t count) override;
+  void getValuesAtIndex(const jsi::Array &arr, size_t index, double *values, size_t count) override;
+  void getValuesAtIndex(const jsi::Array &arr, size_t index, int32_t *values, size_t count) override;
+  void getValuesAtIndex(const jsi::Array &arr, size_t index, std::string *values, size_t count) override;
+  void setValuesAtIndex(const jsi::Array &arr, size_t index, const jsi::Value *values, size_t count) override;
+  void setValuesAtIndex(const jsi::Array &arr, size_t index, const double *values, size_t count) override;
+  void setValuesAtIndex(const jsi::Array &arr, size_t index, const int32_t *values, size_t count) override;
+  void setValuesAtIndex(const jsi::Array &arr, size_t index, const std::string_view *values, size_t count) override;
+  void getProperties(const jsi::Object &obj, const jsi::PropNameID *names, jsi::Value *values, size_t count) override;
+  void setProperties(const jsi::Object &obj, const jsi::PropNameID *names, const jsi::Value *values, size_t count)
+      override;
+
  protected:
   PointerValue *cloneSymbol(const PointerValue *pointerValue) override;
   PointerValue *cloneBigInt(const PointerValue *pointerValue) override;
@@ -482,6 +601,16 @@ class NodeApiJsiRuntime : public jsi::Runtime {
   // The number of arguments that we keep on stack. We use heap if we have more arguments.
   constexpr static size_t MaxStackArgCount = 8;
 
+  // The number of array elements that we read or write at once in the bulk array operations.
+  constexpr static size_t ElementChunkSize = 64;
+
+  // The initial size of the UTF-8 scratch buffer used to read strings in a single pass.
+  constexpr static size_t MinUtf8BufferSize = 256;
+  // The UTF-8 scratch buffer is released after use if it grows above this size.
+  constexpr static size_t MaxRetainedUtf8BufferSize = 64 * 1024;
+  // Node-API does not split UTF-8 sequences when it truncates strings.
+  constexpr static size_t MaxUtf8SequenceLength = 4;
+
   // NodeApiValueArgs helps optimize passing arguments to NAPI functions.
   // If number of arguments is below or equal to MaxStackArgCount, they are kept on the call stack,
   // otherwise arguments are allocated on the heap.
@@ -572,20 +701,75 @@ class NodeApiJsiRuntime : public jsi::Runtime {
     NodeApiJsiRuntime &runtime_;
   };
 
+  // The napi_value that can be reused while the pointer value scope where it was created is open.
+  struct ScopedValue {
+    napi_value value{};
+    size_t scopeDepth{};
+    uint64_t scopeId{};
+  };
+
+  // The range of integer numbers that have cached napi_values.
+  constexpr static int32_t MinCachedInt = -128;
+  constexpr static int32_t MaxCachedInt = 1023;
+
+  // Wraps up the lazy property factory along with the property name and the NodeApiJsiRuntime.
+  class LazyPropertyWrapper {
+   public:
+    LazyPropertyWrapper(
+        const jsi::Object &holder,
+        const jsi::PropNameID &name,
+        LazyValueFactory &&factory,
+        NodeApiJsiRuntime &runtime);
+
+    // Calls the factory and releases it after it succeeds.
+    jsi::Value createValue();
+    void releaseFactory() noexcept;
+
+    jsi::WeakObject &holder() noexcept;
+    const jsi::PropNameID &name() const noexcept;
+    NodeApiJsiRuntime &runtime() noexcept;
+
+    LazyPropertyWrapper(const LazyPropertyWrapper &) = delete;
+    LazyPropertyWrapper &operator=(const LazyPropertyWrapper &) = delete;
+
+   private:
+    jsi::WeakObject holder_;
+    jsi::PropNameID name_;
+    LazyValueFactory factory_;
+    NodeApiJsiRuntime &runtime_;
+  };
+
   // Wraps up the napi_ext_prepared_script.
   class NodeApiPreparedJavaScript final : public jsi::PreparedJavaScript {
    public:
-    NodeApiPreparedJavaScript(napi_env env, napi_ext_prepared_script script, std::string sourceURL)
-        : env_(env), script_(script), sourceURL_(std::move(sourceURL)) {}
+    NodeApiPreparedJavaScript(
+        NodeApi *nodeApi,
+        bool isDefaultScript,
+        napi_env env,
+        napi_ext_prepared_script script,
+        std::string sourceURL)
+        : nodeApi_(nodeApi),
+          isDefaultScript_(isDefaultScript),
+          env_(env),
+          script_(script),
+          sourceURL_(std::move(sourceURL)) {}
 
     ~NodeApiPreparedJavaScript() override {
-      NodeApi::current()->napi_ext_delete_prepared_script(env_, script_);
+      if (isDefaultScript_) {
+        NodeApiDefaults::deletePreparedScript(nodeApi_, env_, script_);
+      } else {
+        nodeApi_->napi_ext_delete_prepared_script(env_, script_);
+      }
     }
 
     napi_ext_prepared_script getScript() const {
       return script_;
     }
 
+    bool isDefaultScript() const {
+      return isDefaultScript_;
+    }
+
     const std::string &sourceURL() const {
       return sourceURL_;
     }
@@ -594,6 +778,9 @@ class NodeApiJsiRuntime : public jsi::Runtime {
     NodeApiPreparedJavaScript &operator=(const NodeApiPreparedJavaScript &) = delete;
 
    private:
+    NodeApi *nodeApi_;
+    // True if the script is created by the NodeApiDefaults::createPreparedScript.
+    bool isDefaultScript_;
     napi_env env_;
     napi_ext_prepared_script script_;
     std::string sourceURL_;
@@ -604,7 +791,8 @@ class NodeApiJsiRuntime : public jsi::Runtime {
   jsi::JSError makeJSError(Args &&...args);
   [[noreturn]] void throwJSException(napi_status errorCode) const;
   [[noreturn]] void throwNativeException(char const *errorMessage) const;
-  void rewriteErrorMessage(napi_value jsError) const;
+  JsiResult makeJsiResult(napi_status status, napi_value result);
+  bool rewriteErrorMessage(napi_value jsError, const jsi::JSError &error) const;
   template <typename TLambda>
   auto runInMethodContext(char const *methodName, TLambda lambda);
   template <typename TLambda>
@@ -614,20 +802,39 @@ class NodeApiJsiRuntime : public jsi::Runtime {
 
  private: // Shared NAPI call helpers
   napi_valuetype typeOf(napi_value value) const;
+  napi_valuetype getTypeAndValue(napi_value value, bool *boolValue, double *doubleValue) const;
   bool strictEquals(napi_value left, napi_value right) const;
   napi_value getUndefined() const;
   napi_value getNull() const;
   napi_value getGlobal() const;
   napi_value getBoolean(bool value) const;
-  bool getValueBool(napi_value value) const;
   napi_value createInt32(int32_t value) const;
   napi_value createUInt32(uint32_t value) const;
   napi_value createDouble(double value) const;
-  double getValueDouble(napi_value value) const;
+  napi_value createNumber(double value) const;
   napi_value createStringLatin1(std::string_view value) const;
   napi_value createStringUtf8(std::string_view value) const;
   napi_value createStringUtf8(const uint8_t *data, size_t length) const;
   std::string stringToStdString(napi_value stringValue) const;
+  size_t getValueStringUtf8(napi_value stringValue, char *buffer, size_t bufferSize) const;
+  std::string_view readStringUtf8(napi_value stringValue, std::string &buffer) const;
+  size_t copyStringUtf8(napi_value stringValue, char *buffer, size_t bufferSize) const;
+  template <typename TAction>
+  std::invoke_result_t<TAction, std::string_view> withStringUtf8(napi_value stringValue, TAction &&action) const;
+  template <typename TCreate>
+  jsi::String createInternedString(std::string_view value, TCreate &&create);
+  void evictStringInternCacheEntry();
+  std::shared_ptr<const jsi::PreparedJavaScript> prepareCachedJavaScript(
+      const std::shared_ptr<const jsi::Buffer> &buffer,
+      const std::string &sourceURL);
+  void evictPreparedScriptCacheEntry();
+  bool canCompileScriptOffThread();
+  std::shared_ptr<const jsi::PreparedJavaScript> prepareCompiledJavaScript(
+      NodeApiScriptCompiler::CompiledScript &compiledScript,
+      std::string sourceURL);
+  napi_status runPreparedScript(const NodeApiPreparedJavaScript &script, napi_value *result) const;
+  size_t getBigIntWordCount(napi_value bigint) const;
+  size_t readBigIntMagnitude(napi_value bigint, bool &isNegative, uint64_t *words, size_t wordCount) const;
   napi_value getPropertyIdFromName(std::string_view value) const;
   napi_value getPropertyIdFromName(const uint8_t *data, size_t length) const;
   napi_value getPropertyIdFromName(napi_value str) const;
@@ -648,11 +855,22 @@ class NodeApiJsiRuntime : public jsi::Runtime {
   size_t getArrayLength(napi_value value) const;
   napi_value getElement(napi_value arr, size_t index) const;
   void setElement(napi_value array, uint32_t index, napi_value value) const;
+  void getElements(napi_value array, size_t index, span<napi_value> elements) const;
+  void setElements(napi_value array, size_t index, span<napi_value> elements) const;
+  template <typename T, typename TConvert>
+  void getElementsInChunks(const jsi::Array &arr, size_t index, T *values, size_t count, TConvert &&convert);
+  template <typename T, typename TConvert>
+  void setElementsInChunks(const jsi::Array &arr, size_t index, const T *values, size_t count, TConvert &&convert);
   static napi_value __cdecl jsiHostFunctionCallback(napi_env env, napi_callback_info info) noexcept;
   napi_value createExternalFunction(napi_value name, int32_t paramCount, napi_callback callback, void *callbackData);
+  static napi_value __cdecl lazyPropertyGetterCallback(napi_env env, napi_callback_info info) noexcept;
+  static napi_value __cdecl lazyPropertySetterCallback(napi_env env, napi_callback_info info) noexcept;
+  static void __cdecl deleteBufferCallback(napi_env env, void *data, void *hint) noexcept;
   napi_value createExternalObject(void *data, napi_finalize finalizeCallback) const;
   template <typename T>
   napi_value createExternalObject(std::unique_ptr<T> &&data) const;
+  template <typename T>
+  void addFinalizer(napi_value object, std::unique_ptr<T> &&data) const;
   void *getExternalData(napi_value object) const;
   const std::shared_ptr<jsi::HostObject> &getJsiHostObject(napi_value obj);
   napi_value getHostObjectProxyHandler();
@@ -695,6 +913,8 @@ class NodeApiJsiRuntime : public jsi::Runtime {
   void popPointerValueScope() noexcept;
   void collectUnusedStackValues();
   void collectUnusedRefs() noexcept;
+  template <typename TCreate>
+  napi_value getScopedValue(ScopedValue &scopedValue, TCreate &&create) const;
 
   napi_env getEnv() const noexcept {
     return env_;
@@ -709,6 +929,7 @@ class NodeApiJsiRuntime : public jsi::Runtime {
   // Property ID cache to improve execution speed.
   struct PropertyId {
     NodeApiRefHolder Error;
+    NodeApiRefHolder Function;
     NodeApiRefHolder Object;
     NodeApiRefHolder Proxy;
     NodeApiRefHolder Symbol;
@@ -735,15 +956,81 @@ class NodeApiJsiRuntime : public jsi::Runtime {
   // Cache of commonly used values.
   struct CachedValue {
     NodeApiRefHolder Error;
+    // The Function constructor used by the default prepared scripts. It is cached before any script can replace it.
+    NodeApiRefHolder Function;
     NodeApiRefHolder Global;
     NodeApiRefHolder HostObjectProxyHandler;
     NodeApiRefHolder ProxyConstructor;
     NodeApiRefHolder SymbolToString;
   } cachedValue_;
 
+  // Cache of primitive values that are valid while their pointer value scope is open.
+  // It avoids the repeated Node-API calls for the most common values.
+  struct PrimitiveValue {
+    ScopedValue Undefined;
+    ScopedValue Null;
+    ScopedValue True;
+    ScopedValue False;
+    std::array<ScopedValue, MaxCachedInt - MinCachedInt + 1> SmallInt;
+  };
+  mutable PrimitiveValue primitiveValue_;
+
+  // Opt-in LRU cache of strings created from ASCII and UTF-8 text. The most recently used entries are at the front.
+  struct StringInternCache {
+    struct Entry {
+      std::string text;
+      NodeApiRefHolder ref;
+    };
+    std::list<Entry> entries;
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> index;
+    size_t maxEntryCount{};
+    size_t maxStringLength{};
+    StringInternCacheStats stats{};
+  } stringInternCache_;
+
+  // The recently used scripts prepared by evaluateJavaScript. The index key is the source content hash.
+  struct PreparedScriptCache {
+    struct Entry {
+      size_t sourceHash;
+      std::string sourceURL;
+      std::shared_ptr<const jsi::Buffer> source;
+      std::shared_ptr<const jsi::PreparedJavaScript> script;
+    };
+    std::list<Entry> entries;
+    std::unordered_multimap<size_t, std::list<Entry>::iterator> index;
+    size_t maxEntryCount{};
+    PreparedScriptCacheStats stats{};
+  } preparedScriptCache_;
+
+  // Tasks of prepareJavaScriptAsync use it on the JS thread to check that the runtime is not deleted.
+  std::shared_ptr<NodeApiJsiRuntime *> asyncPrepareTarget_;
+  // Compiles the scripts of prepareJavaScriptAsync on one background thread. It is created by the first call.
+  std::unique_ptr<NodeApiScriptCompiler> scriptCompiler_;
+  std::optional<bool> canCompileScriptOffThread_;
+
+  // True if the JS engine implements the napi_ext_get_type_and_value. It is checked once on the runtime creation.
+  const bool hasTypeAndValueFunc_;
+
+  // True if the JS engine implements the optional functions. They are checked once on the runtime creation.
+  // The runtime calls the NodeApiDefaults for the missing functions to avoid the NodeApi::current() lookups.
+  const bool hasGetElementsFunc_;
+  const bool hasSetElementsFunc_;
+  const bool hasExternalStringLatin1Func_;
+  const bool hasExternalStringUtf16Func_;
+  const bool hasPreparedScriptFuncs_;
+
+  // The scratch buffer to read UTF-8 strings without heap allocations. Nested reads use their own buffers.
+  mutable std::string utf8Buffer_;
+  mutable bool isUtf8BufferInUse_{false};
+
+  // PropNameIDs cached by getCachedPropNameIDs. The key is the names array address.
+  std::unordered_map<const void *, std::vector<jsi::PropNameID>> propNameIDCache_;
+
   bool hasPendingJSError_{false};
 
   std::vector<size_t> stackScopes_;
+  std::vector<uint64_t> stackScopeIds_;
+  uint64_t lastScopeId_{};
   std::vector<NodeApiStackValueHolder> stackValues_;
   std::vector<NodeApiRefHolder> refs_;
 
@@ -810,14 +1097,72 @@ bool StringKey::EqualTo::operator()(const StringKey &left, const StringKey &righ
   return left.equalTo(right);
 }
 
+//=====================================================================================================================
+// isAscii implementation
+//=====================================================================================================================
+
+bool isAscii(const char *data, size_t length) noexcept {
+  const char *end = data + length;
+#if defined(__AVX2__)
+  for (; end - data >= 32; data += 32) {
+    __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+    if (_mm256_movemask_epi8(chunk) != 0) {
+      return false;
+    }
+  }
+#endif
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  for (; end - data >= 16; data += 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+    if (_mm_movemask_epi8(chunk) != 0) {
+      return false;
+    }
+  }
+#elif defined(__aarch64__) || defined(_M_ARM64)
+  for (; end - data >= 16; data += 16) {
+    uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t *>(data));
+    if (vmaxvq_u8(chunk) >= 0x80) {
+      return false;
+    }
+  }
+#endif
+  // Check the remaining characters eight at a time.
+  for (; end - data >= 8; data += 8) {
+    uint64_t word{};
+    std::memcpy(&word, data, sizeof(word));
+    if ((word & 0x8080808080808080ull) != 0) {
+      return false;
+    }
+  }
+  for (; data < end; ++data) {
+    if ((static_cast<uint8_t>(*data) & 0x80) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
 //=====================================================================================================================
 // NodeApiJsiRuntime implementation
 //=====================================================================================================================
 
 NodeApiJsiRuntime::NodeApiJsiRuntime(napi_env env, NodeApi *nodeApi, std::function<void()> onDelete) noexcept
-    : env_(env), nodeApi_(nodeApi), onDelete_(std::move(onDelete)) {
+    : env_(env),
+      nodeApi_(nodeApi),
+      onDelete_(std::move(onDelete)),
+      hasTypeAndValueFunc_(nodeApi->getFuncPtr("napi_ext_get_type_and_value") != nullptr),
+      hasGetElementsFunc_(nodeApi->getFuncPtr("napi_ext_get_elements") != nullptr),
+      hasSetElementsFunc_(nodeApi->getFuncPtr("napi_ext_set_elements") != nullptr),
+      hasExternalStringLatin1Func_(nodeApi->getFuncPtr("node_api_create_external_string_latin1") != nullptr),
+      hasExternalStringUtf16Func_(nodeApi->getFuncPtr("node_api_create_external_string_utf16") != nullptr),
+      // The prepared script functions are either all provided by the JS engine or all use the defaults.
+      hasPreparedScriptFuncs_(
+          nodeApi->getFuncPtr("napi_ext_create_prepared_script") != nullptr &&
+          nodeApi->getFuncPtr("napi_ext_delete_prepared_script") != nullptr &&
+          nodeApi->getFuncPtr("napi_ext_prepared_script_run") != nullptr) {
   NodeApiScope scope{*this};
   propertyId_.Error = makeNodeApiRef(getPropertyIdFromName("Error"), NodeApiPointerValueKind::String);
+  propertyId_.Function = makeNodeApiRef(getPropertyIdFromName("Function"), NodeApiPointerValueKind::String);
   propertyId_.Object = makeNodeApiRef(getPropertyIdFromName("Object"), NodeApiPointerValueKind::String);
   propertyId_.Proxy = makeNodeApiRef(getPropertyIdFromName("Proxy"), NodeApiPointerValueKind::String);
   propertyId_.Symbol = makeNodeApiRef(getPropertyIdFromName("Symbol"), NodeApiPointerValueKind::String);
@@ -846,9 +1191,19 @@ NodeApiJsiRuntime::NodeApiJsiRuntime(napi_env env, NodeApi *nodeApi, std::functi
   cachedValue_.Error = makeNodeApiRef(
       getProperty(getNodeApiValue(cachedValue_.Global), getNodeApiValue(propertyId_.Error)),
       NodeApiPointerValueKind::Object);
+  cachedValue_.Function = makeNodeApiRef(
+      getProperty(getNodeApiValue(cachedValue_.Global), getNodeApiValue(propertyId_.Function)),
+      NodeApiPointerValueKind::Object);
 }
 
 NodeApiJsiRuntime::~NodeApiJsiRuntime() {
+  // The prepared scripts must be deleted while the env is still alive.
+  enablePreparedScriptCache(0);
+  if (asyncPrepareTarget_) {
+    *asyncPrepareTarget_ = nullptr;
+  }
+  // The compiler stops using the NodeApi before the runtime owner can delete it.
+  scriptCompiler_.reset();
   if (onDelete_) {
     onDelete_();
   }
@@ -857,48 +1212,145 @@ NodeApiJsiRuntime::~NodeApiJsiRuntime() {
 jsi::Value NodeApiJsiRuntime::evaluateJavaScript(
     const std::shared_ptr<const jsi::Buffer> &buffer,
     const std::string &sourceURL) {
-  return evaluatePreparedJavaScript(prepareJavaScript(buffer, sourceURL));
+  PROFILE_JSI_METHOD();
+  if (preparedScriptCache_.maxEntryCount == 0) {
+    return evaluatePreparedJavaScript(prepareJavaScript(buffer, sourceURL));
+  }
+  return evaluatePreparedJavaScript(prepareCachedJavaScript(buffer, sourceURL));
 }
 
 std::shared_ptr<const jsi::PreparedJavaScript> NodeApiJsiRuntime::prepareJavaScript(
     const std::shared_ptr<const jsi::Buffer> &sourceBuffer,
     std::string sourceURL) {
+  PROFILE_JSI_METHOD();
   NodeApiScope scope{*this};
   napi_ext_prepared_script script{};
-  napi_status status = nodeApi_->napi_ext_create_prepared_script(
-      env_,
-      const_cast<uint8_t *>(sourceBuffer->data()),
-      sourceBuffer->size(),
-      [](napi_env /*env*/, void * /*data*/, void *finalizeHint) {
-        delete reinterpret_cast<std::shared_ptr<const jsi::Buffer> *>(finalizeHint);
-      },
-      new std::shared_ptr<const jsi::Buffer>(sourceBuffer),
-      sourceURL.c_str(),
-      &script);
+  uint8_t *scriptData = const_cast<uint8_t *>(sourceBuffer->data());
+  napi_finalize finalizeCallback = [](napi_env /*env*/, void * /*data*/, void *finalizeHint) {
+    delete reinterpret_cast<std::shared_ptr<const jsi::Buffer> *>(finalizeHint);
+  };
+  auto finalizeHint = new std::shared_ptr<const jsi::Buffer>(sourceBuffer);
+  napi_status status = hasPreparedScriptFuncs_
+      ? nodeApi_->napi_ext_create_prepared_script(
+            env_, scriptData, sourceBuffer->size(), finalizeCallback, finalizeHint, sourceURL.c_str(), &script)
+      : NodeApiDefaults::createPreparedScript(
+            nodeApi_,
+            hasExternalStringLatin1Func_,
+            env_,
+            scriptData,
+            sourceBuffer->size(),
+            finalizeCallback,
+            finalizeHint,
+            sourceURL.c_str(),
+            &script);
   CHECK_NAPI(status); // Not for the call to keep better automated formatting.
-  return std::make_shared<NodeApiPreparedJavaScript>(env_, script, std::move(sourceURL));
+  return std::make_shared<NodeApiPreparedJavaScript>(
+      nodeApi_, !hasPreparedScriptFuncs_, env_, script, std::move(sourceURL));
+}
+
+void NodeApiJsiRuntime::prepareJavaScriptAsync(
+    const std::shared_ptr<const jsi::Buffer> &buffer,
+    std::string sourceURL,
+    JSThreadDispatcher dispatcher,
+    PrepareJavaScriptCallback callback) {
+  PROFILE_JSI_METHOD();
+  if (!canCompileScriptOffThread()) {
+    std::shared_ptr<const jsi::PreparedJavaScript> script;
+    std::exception_ptr error;
+    try {
+      script = prepareJavaScript(buffer, std::move(sourceURL));
+    } catch (...) {
+      error = std::current_exception();
+    }
+    callback(std::move(script), std::move(error));
+    return;
+  }
+
+  if (!asyncPrepareTarget_) {
+    asyncPrepareTarget_ = std::make_shared<NodeApiJsiRuntime *>(this);
+    scriptCompiler_ = std::make_unique<NodeApiScriptCompiler>(nodeApi_);
+  }
+  scriptCompiler_->compileAsync(
+      buffer,
+      sourceURL,
+      [target = asyncPrepareTarget_,
+       buffer,
+       sourceURL,
+       dispatcher = std::move(dispatcher),
+       callback = std::move(callback)](std::shared_ptr<NodeApiScriptCompiler::CompiledScript> compiledScript) mutable {
+        dispatcher([target = std::move(target),
+                    buffer = std::move(buffer),
+                    sourceURL = std::move(sourceURL),
+                    callback = std::move(callback),
+                    compiledScript = std::move(compiledScript)]() mutable {
+          if (NodeApiJsiRuntime *runtime = *target) {
+            std::shared_ptr<const jsi::PreparedJavaScript> script;
+            std::exception_ptr error;
+            try {
+              script = compiledScript->status() == napi_ok
+                  ? runtime->prepareCompiledJavaScript(*compiledScript, std::move(sourceURL))
+                  : runtime->prepareJavaScript(buffer, std::move(sourceURL));
+            } catch (...) {
+              error = std::current_exception();
+            }
+            callback(std::move(script), std::move(error));
+          }
+        });
+      });
+}
+
+// Creates the prepared script from the script compiled by prepareJavaScriptAsync on a background thread.
+std::shared_ptr<const jsi::PreparedJavaScript> NodeApiJsiRuntime::prepareCompiledJavaScript(
+    NodeApiScriptCompiler::CompiledScript &compiledScript,
+    std::string sourceURL) {
+  NodeApiScope scope{*this};
+  napi_ext_prepared_script script{};
+  CHECK_NAPI(nodeApi_->napi_ext_create_prepared_script_from_compiled(env_, compiledScript.release(), &script));
+  return std::make_shared<NodeApiPreparedJavaScript>(nodeApi_, false, env_, script, std::move(sourceURL));
+}
+
+// Returns true if the JS engine implements the script compilation outside of the JS thread.
+// The compiled scripts become the JS engine prepared scripts, and they can only be run by the JS engine functions.
+bool NodeApiJsiRuntime::canCompileScriptOffThread() {
+  if (!canCompileScriptOffThread_.has_value()) {
+    canCompileScriptOffThread_ = hasPreparedScriptFuncs_ &&
+        nodeApi_->getFuncPtr("napi_ext_compile_script") != nullptr &&
+        nodeApi_->getFuncPtr("napi_ext_create_prepared_script_from_compiled") != nullptr;
+  }
+  return *canCompileScriptOffThread_;
+}
+
+napi_status NodeApiJsiRuntime::runPreparedScript(const NodeApiPreparedJavaScript &script, napi_value *result) const {
+  return script.isDefaultScript()
+      ? NodeApiDefaults::runPreparedScript(
+            nodeApi_, env_, script.getScript(), getNodeApiValue(cachedValue_.Function), result)
+      : nodeApi_->napi_ext_prepared_script_run(env_, script.getScript(), result);
 }
 
 jsi::Value NodeApiJsiRuntime::evaluatePreparedJavaScript(const std::shared_ptr<const jsi::PreparedJavaScript> &js) {
+  PROFILE_JSI_METHOD();
   NodeApiScope scope{*this};
   auto preparedScript = static_cast<const NodeApiPreparedJavaScript *>(js.get());
   AutoRestore<std::string> sourceURLScope{sourceURL_, preparedScript->sourceURL()};
   napi_value result{};
-  CHECK_NAPI(nodeApi_->napi_ext_prepared_script_run(env_, preparedScript->getScript(), &result));
+  CHECK_NAPI(runPreparedScript(*preparedScript, &result));
   return toJsiValue(result);
 }
 
 bool NodeApiJsiRuntime::drainMicrotasks(int maxMicrotasksHint) {
+  PROFILE_JSI_METHOD();
   bool result{};
   CHECK_NAPI(nodeApi_->napi_ext_drain_microtasks(env_, maxMicrotasksHint, &result));
   return result;
 }
 
 jsi::Object NodeApiJsiRuntime::global() {
+  PROFILE_JSI_METHOD();
   return make<jsi::Object>(cachedValue_.Global->clone(*this));
 }
 
 std::string NodeApiJsiRuntime::description() {
+  PROFILE_JSI_METHOD();
   size_t length{};
   CHECK_NAPI(nodeApi_->napi_ext_get_description(env_, nullptr, 0, &length));
   std::string desc(length, '\0');
@@ -907,32 +1359,309 @@ std::string NodeApiJsiRuntime::description() {
 }
 
 bool NodeApiJsiRuntime::isInspectable() {
+  PROFILE_JSI_METHOD();
   bool result{};
   CHECK_NAPI(nodeApi_->napi_ext_is_inspectable(env_, &result));
   return result;
 }
 
+void NodeApiJsiRuntime::getValuesAtIndex(const jsi::Array &arr, size_t index, jsi::Value *values, size_t count) {
+  PROFILE_JSI_METHOD();
+  // The jsi::Values must keep napi_values in the current scope.
+  std::array<napi_value, ElementChunkSize> elements;
+  for (size_t chunkStart = 0; chunkStart < count; chunkStart += ElementChunkSize) {
+    const size_t chunkSize = std::min(count - chunkStart, ElementChunkSize);
+    getElements(getNodeApiValue(arr), index + chunkStart, span<napi_value>(elements.data(), chunkSize));
+    for (size_t i = 0; i < chunkSize; ++i) {
+      values[chunkStart + i] = toJsiValue(elements[i]);
+    }
+  }
+}
+
+void NodeApiJsiRuntime::getValuesAtIndex(const jsi::Array &arr, size_t index, double *values, size_t count) {
+  PROFILE_JSI_METHOD();
+  getElementsInChunks(arr, index, values, count, [this](napi_value element) {
+    double result{};
+    napi_status status = nodeApi_->napi_get_value_double(env_, element, &result);
+    CHECK_ELSE_THROW(status != napi_number_expected, "The array element is not a Number.");
+    CHECK_NAPI(status);
+    return result;
+  });
+}
+
+void NodeApiJsiRuntime::getValuesAtIndex(const jsi::Array &arr, size_t index, int32_t *values, size_t count) {
+  PROFILE_JSI_METHOD();
+  getElementsInChunks(arr, index, values, count, [this](napi_value element) {
+    int32_t result{};
+    napi_status status = nodeApi_->napi_get_value_int32(env_, element, &result);
+    CHECK_ELSE_THROW(status != napi_number_expected, "The array element is not a Number.");
+    CHECK_NAPI(status);
+    return result;
+  });
+}
+
+void NodeApiJsiRuntime::getValuesAtIndex(const jsi::Array &arr, size_t index, std::string *values, size_t count) {
+  PROFILE_JSI_METHOD();
+  getElementsInChunks(arr, index, values, count, [this](napi_value element) { return stringToStdString(element); });
+}
+
+void NodeApiJsiRuntime::setValuesAtIndex(
+    const jsi::Array &arr,
+    size_t index,
+    const jsi::Value *values,
+    size_t count) {
+  PROFILE_JSI_METHOD();
+  setElementsInChunks(arr, index, values, count, [this](const jsi::Value &value) { return getNodeApiValue(value); });
+}
+
+void NodeApiJsiRuntime::setValuesAtIndex(const jsi::Array &arr, size_t index, const double *values, size_t count) {
+  PROFILE_JSI_METHOD();
+  setElementsInChunks(arr, index, values, count, [this](double value) { return createNumber(value); });
+}
+
+void NodeApiJsiRuntime::setValuesAtIndex(const jsi::Array &arr, size_t index, const int32_t *values, size_t count) {
+  PROFILE_JSI_METHOD();
+  setElementsInChunks(arr, index, values, count, [this](int32_t value) { return createInt32(value); });
+}
+
+void NodeApiJsiRuntime::setValuesAtIndex(
+    const jsi::Array &arr,
+    size_t index,
+    const std::string_view *values,
+    size_t count) {
+  PROFILE_JSI_METHOD();
+  setElementsInChunks(arr, index, values, count, [this](std::string_view value) { return createStringUtf8(value); });
+}
+
+void NodeApiJsiRuntime::getProperties(
+    const jsi::Object &obj,
+    const jsi::PropNameID *names,
+    jsi::Value *values,
+    size_t count) {
+  PROFILE_JSI_METHOD();
+  // The object and keys are resolved before the reads. The jsi::Values must keep napi_values in the current scope.
+  // N-API has no bulk read of named properties like napi_ext_get_elements, and each value is read by one call.
+  napi_value object = getNodeApiValue(obj);
+  SmallBuffer<napi_value, MaxStackArgCount> keys(count);
+  for (size_t i = 0; i < count; ++i) {
+    keys.data()[i] = getNodeApiValue(names[i]);
+  }
+  SmallBuffer<napi_value, MaxStackArgCount> results(count);
+  for (size_t i = 0; i < count; ++i) {
+    CHECK_NAPI(nodeApi_->napi_get_property(env_, object, keys.data()[i], &results.data()[i]));
+  }
+  for (size_t i = 0; i < count; ++i) {
+    values[i] = toJsiValue(results.data()[i]);
+  }
+}
+
+void NodeApiJsiRuntime::setProperties(
+    const jsi::Object &obj,
+    const jsi::PropNameID *names,
+    const jsi::Value *values,
+    size_t count) {
+  PROFILE_JSI_METHOD();
+  SmallBuffer<napi_property_descriptor, MaxStackArgCount> descriptors(count);
+  for (size_t i = 0; i < count; ++i) {
+    napi_property_descriptor &descriptor = descriptors.data()[i];
+    descriptor = {};
+    descriptor.name = getNodeApiValue(names[i]);
+    descriptor.value = getNodeApiValue(values[i]);
+    descriptor.attributes = napi_default_jsproperty;
+  }
+  CHECK_NAPI(nodeApi_->napi_define_properties(env_, getNodeApiValue(obj), count, descriptors.data()));
+}
+
+const jsi::PropNameID *NodeApiJsiRuntime::getCachedPropNameIDs(const char *const *names, size_t count) {
+  PROFILE_JSI_METHOD();
+  auto it = propNameIDCache_.find(names);
+  if (it == propNameIDCache_.end()) {
+    std::vector<jsi::PropNameID> propNameIDs;
+    propNameIDs.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      propNameIDs.push_back(
+          jsi::PropNameID::forUtf8(*this, reinterpret_cast<const uint8_t *>(names[i]), std::strlen(names[i])));
+    }
+    it = propNameIDCache_.emplace(names, std::move(propNameIDs)).first;
+  }
+  CHECK_ELSE_THROW(it->second.size() == count, "The cached PropNameID count does not match.");
+  return it->second.data();
+}
+
+void NodeApiJsiRuntime::getUtf8(const jsi::String &str, void *context, Utf8Callback callback) {
+  PROFILE_JSI_METHOD();
+  withStringUtf8(getNodeApiValue(str), [context, callback](std::string_view utf8) { callback(context, utf8); });
+}
+
+void NodeApiJsiRuntime::getUtf8(const jsi::PropNameID &name, void *context, Utf8Callback callback) {
+  PROFILE_JSI_METHOD();
+  napi_value propertyId = getNodeApiValue(name);
+  if (typeOf(propertyId) == napi_symbol) {
+    std::string symbolStr = symbolToStdString(propertyId);
+    callback(context, symbolStr);
+  } else {
+    withStringUtf8(propertyId, [context, callback](std::string_view utf8) { callback(context, utf8); });
+  }
+}
+
+size_t NodeApiJsiRuntime::copyUtf8(const jsi::String &str, char *buffer, size_t bufferSize) {
+  PROFILE_JSI_METHOD();
+  return copyStringUtf8(getNodeApiValue(str), buffer, bufferSize);
+}
+
+size_t NodeApiJsiRuntime::copyUtf8(const jsi::PropNameID &name, char *buffer, size_t bufferSize) {
+  PROFILE_JSI_METHOD();
+  napi_value propertyId = getNodeApiValue(name);
+  if (typeOf(propertyId) == napi_symbol) {
+    std::string symbolStr = symbolToStdString(propertyId);
+    if (symbolStr.size() <= bufferSize) {
+      std::memcpy(buffer, symbolStr.data(), symbolStr.size());
+    }
+    return symbolStr.size();
+  }
+  return copyStringUtf8(propertyId, buffer, bufferSize);
+}
+
+jsi::String NodeApiJsiRuntime::createExternalStringFromUtf8(const std::shared_ptr<const jsi::Buffer> &buffer) {
+  PROFILE_JSI_METHOD();
+  CHECK_ELSE_THROW(buffer, "Cannot create a JS string from a null buffer.");
+  char *data = reinterpret_cast<char *>(const_cast<uint8_t *>(buffer->data()));
+  if (!isAscii(data, buffer->size())) {
+    return makeJsiPointer<jsi::String>(createStringUtf8({data, buffer->size()}));
+  }
+
+  // The deleteBufferCallback deletes the bufferHolder after the string is collected or copied.
+  auto bufferHolder = std::make_unique<std::shared_ptr<const jsi::Buffer>>(buffer);
+  napi_value result{};
+  bool copied{};
+  CHECK_NAPI(
+      hasExternalStringLatin1Func_
+          ? nodeApi_->node_api_create_external_string_latin1(
+                env_, data, buffer->size(), deleteBufferCallback, bufferHolder.get(), &result, &copied)
+          : NodeApiDefaults::createExternalStringLatin1(
+                nodeApi_, env_, data, buffer->size(), deleteBufferCallback, bufferHolder.get(), &result, &copied));
+  bufferHolder.release();
+  return makeJsiPointer<jsi::String>(result);
+}
+
+jsi::String NodeApiJsiRuntime::createExternalStringFromUtf16(const std::shared_ptr<const jsi::Buffer> &buffer) {
+  PROFILE_JSI_METHOD();
+  CHECK_ELSE_THROW(buffer, "Cannot create a JS string from a null buffer.");
+  CHECK_ELSE_THROW(
+      buffer->size() % sizeof(char16_t) == 0 && reinterpret_cast<uintptr_t>(buffer->data()) % alignof(char16_t) == 0,
+      "The UTF-16 buffer must be aligned and have an even size.");
+  auto bufferHolder = std::make_unique<std::shared_ptr<const jsi::Buffer>>(buffer);
+  napi_value result{};
+  bool copied{};
+  char16_t *data = reinterpret_cast<char16_t *>(const_cast<uint8_t *>(buffer->data()));
+  size_t length = buffer->size() / sizeof(char16_t);
+  CHECK_NAPI(
+      hasExternalStringUtf16Func_
+          ? nodeApi_->node_api_create_external_string_utf16(
+                env_, data, length, deleteBufferCallback, bufferHolder.get(), &result, &copied)
+          : NodeApiDefaults::createExternalStringUtf16(
+                nodeApi_, env_, data, length, deleteBufferCallback, bufferHolder.get(), &result, &copied));
+  bufferHolder.release();
+  return makeJsiPointer<jsi::String>(result);
+}
+
+jsi::String NodeApiJsiRuntime::createStringFromUtf16(const char16_t *utf16, size_t length) {
+  PROFILE_JSI_METHOD();
+  CHECK_ELSE_THROW(utf16 || length == 0, "Cannot convert a nullptr to a JS string.");
+  napi_value result{};
+  CHECK_NAPI(nodeApi_->napi_create_string_utf16(env_, utf16 ? utf16 : u"", length, &result));
+  return makeJsiPointer<jsi::String>(result);
+}
+
+std::u16string NodeApiJsiRuntime::utf16(const jsi::String &str) {
+  PROFILE_JSI_METHOD();
+  napi_value stringValue = getNodeApiValue(str);
+  size_t length{};
+  CHECK_NAPI(nodeApi_->napi_get_value_string_utf16(env_, stringValue, nullptr, 0, &length));
+  std::u16string result(length, u'\0');
+  size_t copiedLength{};
+  CHECK_NAPI(nodeApi_->napi_get_value_string_utf16(env_, stringValue, result.data(), length + 1, &copiedLength));
+  CHECK_ELSE_THROW(copiedLength == length, "Unexpected string length");
+  return result;
+}
+
+void NodeApiJsiRuntime::enableStringInternCache(size_t maxEntryCount, size_t maxStringLength) {
+  PROFILE_JSI_METHOD();
+  stringInternCache_.maxEntryCount = maxEntryCount;
+  stringInternCache_.maxStringLength = maxStringLength;
+  while (stringInternCache_.entries.size() > maxEntryCount) {
+    evictStringInternCacheEntry();
+  }
+}
+
+INodeApiJsiRuntime::StringInternCacheStats NodeApiJsiRuntime::getStringInternCacheStats() {
+  PROFILE_JSI_METHOD();
+  StringInternCacheStats stats = stringInternCache_.stats;
+  stats.entryCount = stringInternCache_.entries.size();
+  return stats;
+}
+
+void NodeApiJsiRuntime::enablePreparedScriptCache(size_t maxEntryCount) {
+  PROFILE_JSI_METHOD();
+  preparedScriptCache_.maxEntryCount = maxEntryCount;
+  while (preparedScriptCache_.entries.size() > maxEntryCount) {
+    evictPreparedScriptCacheEntry();
+  }
+}
+
+INodeApiJsiRuntime::PreparedScriptCacheStats NodeApiJsiRuntime::getPreparedScriptCacheStats() {
+  PROFILE_JSI_METHOD();
+  PreparedScriptCacheStats stats = preparedScriptCache_.stats;
+  stats.entryCount = preparedScriptCache_.entries.size();
+  return stats;
+}
+
+void NodeApiJsiRuntime::defineLazyProperty(
+    const jsi::Object &obj,
+    const jsi::PropNameID &name,
+    LazyValueFactory factory) {
+  PROFILE_JSI_METHOD();
+  // The lazyPropertyWrapper is deleted when the obj is garbage collected.
+  // The accessor property can only be reached while the obj is alive.
+  auto lazyPropertyWrapper = std::make_unique<LazyPropertyWrapper>(obj, name, std::move(factory), *this);
+  napi_property_descriptor descriptor{};
+  descriptor.name = getNodeApiValue(name);
+  descriptor.getter = lazyPropertyGetterCallback;
+  descriptor.setter = lazyPropertySetterCallback;
+  descriptor.attributes = static_cast<napi_property_attributes>(napi_enumerable | napi_configurable);
+  descriptor.data = lazyPropertyWrapper.get();
+  napi_value object = getNodeApiValue(obj);
+  addFinalizer(object, std::move(lazyPropertyWrapper));
+  CHECK_NAPI(nodeApi_->napi_define_properties(env_, object, 1, &descriptor));
+}
+
 jsi::Runtime::PointerValue *NodeApiJsiRuntime::cloneSymbol(const jsi::Runtime::PointerValue *pointerValue) {
+  PROFILE_JSI_METHOD();
   return cloneNodeApiPointerValue(pointerValue);
 }
 
 jsi::Runtime::PointerValue *NodeApiJsiRuntime::cloneBigInt(const jsi::Runtime::PointerValue *pointerValue) {
+  PROFILE_JSI_METHOD();
   return cloneNodeApiPointerValue(pointerValue);
 }
 
 jsi::Runtime::PointerValue *NodeApiJsiRuntime::cloneString(const jsi::Runtime::PointerValue *pointerValue) {
+  PROFILE_JSI_METHOD();
   return cloneNodeApiPointerValue(pointerValue);
 }
 
 jsi::Runtime::PointerValue *NodeApiJsiRuntime::cloneObject(const jsi::Runtime::PointerValue *pointerValue) {
+  PROFILE_JSI_METHOD();
   return cloneNodeApiPointerValue(pointerValue);
 }
 
 jsi::Runtime::PointerValue *NodeApiJsiRuntime::clonePropNameID(const jsi::Runtime::PointerValue *pointerValue) {
+  PROFILE_JSI_METHOD();
   return cloneNodeApiPointerValue(pointerValue);
 }
 
 jsi::PropNameID NodeApiJsiRuntime::createPropNameIDFromAscii(const char *str, size_t length) {
+  PROFILE_JSI_METHOD();
   StringKey keyName{str, length};
   auto it = propNameIDs_.find(keyName);
   if (it != propNameIDs_.end()) {
@@ -954,6 +1683,11 @@ jsi::PropNameID NodeApiJsiRuntime::createPropNameIDFromAscii(const char *str, si
 }
 
 jsi::PropNameID NodeApiJsiRuntime::createPropNameIDFromUtf8(const uint8_t *utf8, size_t length) {
+  PROFILE_JSI_METHOD();
+  if (isAscii(reinterpret_cast<const char *>(utf8), length)) {
+    return createPropNameIDFromAscii(reinterpret_cast<const char *>(utf8), length);
+  }
+
   StringKey keyName{reinterpret_cast<const char *>(utf8), length};
   auto it = propNameIDs_.find(keyName);
   if (it != propNameIDs_.end()) {
@@ -975,6 +1709,7 @@ jsi::PropNameID NodeApiJsiRuntime::createPropNameIDFromUtf8(const uint8_t *utf8,
 }
 
 jsi::PropNameID NodeApiJsiRuntime::createPropNameIDFromString(const jsi::String &str) {
+  PROFILE_JSI_METHOD();
   const NodeApiPointerValue *pv = static_cast<const NodeApiPointerValue *>(getPointerValue(str));
   if (pv->getKind() == NodeApiPointerValueKind::StringPropNameID) {
     return make<jsi::PropNameID>(pv->clone(*this));
@@ -1001,35 +1736,42 @@ jsi::PropNameID NodeApiJsiRuntime::createPropNameIDFromString(const jsi::String
 }
 
 jsi::PropNameID NodeApiJsiRuntime::createPropNameIDFromSymbol(const jsi::Symbol &sym) {
+  PROFILE_JSI_METHOD();
   // TODO: Should we ensure uniqueness of symbols?
   return cloneAs<jsi::PropNameID>(sym);
 }
 
 std::string NodeApiJsiRuntime::utf8(const jsi::PropNameID &id) {
+  PROFILE_JSI_METHOD();
   return propertyIdToStdString(getNodeApiValue(id));
 }
 
 bool NodeApiJsiRuntime::compare(const jsi::PropNameID &lhs, const jsi::PropNameID &rhs) {
+  PROFILE_JSI_METHOD();
   return getPointerValue(lhs) == getPointerValue(rhs) || strictEquals(getNodeApiValue(lhs), getNodeApiValue(rhs));
 }
 
 std::string NodeApiJsiRuntime::symbolToString(const jsi::Symbol &sym) {
+  PROFILE_JSI_METHOD();
   return symbolToStdString(getNodeApiValue(sym));
 }
 
 jsi::BigInt NodeApiJsiRuntime::createBigIntFromInt64(int64_t val) {
+  PROFILE_JSI_METHOD();
   napi_value bigint{};
   CHECK_NAPI(nodeApi_->napi_create_bigint_int64(env_, val, &bigint));
   return makeJsiPointer<jsi::BigInt>(bigint);
 }
 
 jsi::BigInt NodeApiJsiRuntime::createBigIntFromUint64(uint64_t val) {
+  PROFILE_JSI_METHOD();
   napi_value bigint{};
   CHECK_NAPI(nodeApi_->napi_create_bigint_uint64(env_, val, &bigint));
   return makeJsiPointer<jsi::BigInt>(bigint);
 }
 
 bool NodeApiJsiRuntime::bigintIsInt64(const jsi::BigInt &bigint) {
+  PROFILE_JSI_METHOD();
   napi_value value = getNodeApiValue(bigint);
   bool lossless{false};
   int64_t result{};
@@ -1038,6 +1780,7 @@ bool NodeApiJsiRuntime::bigintIsInt64(const jsi::BigInt &bigint) {
 }
 
 bool NodeApiJsiRuntime::bigintIsUint64(const jsi::BigInt &bigint) {
+  PROFILE_JSI_METHOD();
   napi_value value = getNodeApiValue(bigint);
   bool lossless{false};
   uint64_t result{};
@@ -1046,6 +1789,7 @@ bool NodeApiJsiRuntime::bigintIsUint64(const jsi::BigInt &bigint) {
 }
 
 uint64_t NodeApiJsiRuntime::truncate(const jsi::BigInt &bigint) {
+  PROFILE_JSI_METHOD();
   napi_value value = getNodeApiValue(bigint);
   bool lossless{false};
   uint64_t result{};
@@ -1053,157 +1797,399 @@ uint64_t NodeApiJsiRuntime::truncate(const jsi::BigInt &bigint) {
   return result;
 }
 
-inline uint32_t constexpr maxCharsPerDigitInRadix(int32_t radix) {
-  // To compute the lower bound of bits in a BigIntDigitType "covered" by a
-  // char. For power of 2 radixes, it is known (exactly) that each character
-  // covers log2(radix) bits. For non-power of 2 radixes, a lower bound is
-  // log2(greatest power of 2 that is less than radix).
-  uint32_t minNumBitsPerChar = radix < 4 ? 1 : radix < 8 ? 2 : radix < 16 ? 3 : radix < 32 ? 4 : 5;
+JsiResult
+NodeApiJsiRuntime::tryCall(const jsi::Function &func, const jsi::Value &jsThis, const jsi::Value *args, size_t count) {
+  PROFILE_JSI_METHOD();
+  NodeApiValueArgs nodeApiArgs(*this, span<const jsi::Value>(args, count));
+  span<napi_value> argSpan = nodeApiArgs;
+  napi_value result{};
+  napi_status status = nodeApi_->napi_call_function(
+      env_, getNodeApiValue(jsThis), getNodeApiValue(func), argSpan.size(), argSpan.begin(), &result);
+  return makeJsiResult(status, result);
+}
+
+JsiResult NodeApiJsiRuntime::tryGetProperty(const jsi::Object &obj, const jsi::PropNameID &name) {
+  PROFILE_JSI_METHOD();
+  napi_value result{};
+  napi_status status = nodeApi_->napi_get_property(env_, getNodeApiValue(obj), getNodeApiValue(name), &result);
+  return makeJsiResult(status, result);
+}
+
+JsiResult
+NodeApiJsiRuntime::tryEvaluate(const std::shared_ptr<const jsi::Buffer> &buffer, const std::string &sourceURL) {
+  PROFILE_JSI_METHOD();
+  std::shared_ptr<const jsi::PreparedJavaScript> script;
+  try {
+    // The syntax errors are thrown only once per script and they are not expected on the hot paths.
+    script = preparedScriptCache_.maxEntryCount == 0 ? prepareJavaScript(buffer, sourceURL)
+                                                     : prepareCachedJavaScript(buffer, sourceURL);
+  } catch (const jsi::JSError &error) {
+    return JsiResult::failure(jsi::Value(*this, error.value()));
+  }
 
-  // With minNumBitsPerChar being the lower bound estimate of how many bits each
-  // char can represent, the upper bound of how many chars "fit" in a bigint
-  // digit is ceil(sizeofInBits(bigint digit) / minNumBitsPerChar).
-  uint32_t numCharsPerDigits = sizeof(uint64_t) / (1 << minNumBitsPerChar);
+  NodeApiScope scope{*this};
+  auto preparedScript = static_cast<const NodeApiPreparedJavaScript *>(script.get());
+  AutoRestore<std::string> sourceURLScope{sourceURL_, preparedScript->sourceURL()};
+  napi_value result{};
+  return makeJsiResult(runPreparedScript(*preparedScript, &result), result);
+}
 
-  return numCharsPerDigits;
+jsi::BigInt NodeApiJsiRuntime::createBigIntFromWords(bool isNegative, const uint64_t *words, size_t wordCount) {
+  PROFILE_JSI_METHOD();
+  CHECK_ELSE_THROW(words || wordCount == 0, "Cannot create a BigInt from a nullptr.");
+  uint64_t zero{};
+  napi_value bigint{};
+  CHECK_NAPI(nodeApi_->napi_create_bigint_words(env_, isNegative ? 1 : 0, wordCount, words ? words : &zero, &bigint));
+  return makeJsiPointer<jsi::BigInt>(bigint);
 }
 
-// Return the high 32 bits of a 64 bit value.
-constexpr inline uint32_t Hi_32(uint64_t Value) {
-  return static_cast<uint32_t>(Value >> 32);
+size_t NodeApiJsiRuntime::getBigIntWords(
+    const jsi::BigInt &bigint,
+    bool *isNegative,
+    uint64_t *words,
+    size_t wordCapacity) {
+  PROFILE_JSI_METHOD();
+  napi_value value = getNodeApiValue(bigint);
+  size_t wordCount = getBigIntWordCount(value);
+  bool signBit{};
+  if (wordCount <= wordCapacity) {
+    wordCount = readBigIntMagnitude(value, signBit, words, wordCount);
+  } else {
+    // The magnitude may still fit after the leading zero words are removed.
+    SmallBuffer<uint64_t, MaxStackArgCount> wordBuffer(wordCount);
+    wordCount = readBigIntMagnitude(value, signBit, wordBuffer.data(), wordBuffer.size());
+    if (wordCount <= wordCapacity) {
+      std::copy_n(wordBuffer.data(), wordCount, words);
+    }
+  }
+  if (isNegative) {
+    *isNegative = signBit;
+  }
+  return wordCount;
 }
 
-// Return the low 32 bits of a 64 bit value.
-constexpr inline uint32_t Lo_32(uint64_t Value) {
-  return static_cast<uint32_t>(Value);
+//---------------------------------------------------------------------------------------------------------------------
+// BigInt to string conversion helpers.
+// The BigInt magnitude is stored as little-endian 32-bit limbs without leading zero limbs.
+//---------------------------------------------------------------------------------------------------------------------
+
+constexpr char BigIntDigitChars[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+// Values with more limbs use the divide-and-conquer conversion.
+constexpr size_t BigIntDivideAndConquerThreshold = 64;
+
+using BigIntLimbs = std::vector<uint32_t>;
+
+void trimLimbs(BigIntLimbs &limbs) noexcept {
+  while (!limbs.empty() && limbs.back() == 0) {
+    limbs.pop_back();
+  }
 }
 
-// Make a 64-bit integer from a high / low pair of 32-bit integers.
-constexpr inline uint64_t Make_64(uint32_t High, uint32_t Low) {
-  return ((uint64_t)High << 32) | (uint64_t)Low;
+uint32_t countLeadingZeros(uint32_t value) noexcept {
+  uint32_t count = 0;
+  for (uint32_t mask = 0x80000000u; mask != 0 && (value & mask) == 0; mask >>= 1) {
+    ++count;
+  }
+  return count;
 }
 
-jsi::String NodeApiJsiRuntime::bigintToString(const jsi::BigInt &bigint, int32_t radix) {
-  if (radix < 2 || radix > 36) {
-    throw makeJSError("Invalid radix ", radix, " to BigInt.toString");
+// Divides limbs by the divisor in place and returns the remainder.
+uint32_t divideLimbs(BigIntLimbs &limbs, uint32_t divisor) noexcept {
+  uint64_t remainder = 0;
+  for (size_t i = limbs.size(); i > 0; --i) {
+    uint64_t dividend = (remainder << 32) | limbs[i - 1];
+    limbs[i - 1] = static_cast<uint32_t>(dividend / divisor);
+    remainder = dividend % divisor;
   }
+  trimLimbs(limbs);
+  return static_cast<uint32_t>(remainder);
+}
 
-  napi_value value = getNodeApiValue(bigint);
-  size_t wordCount{};
-  CHECK_NAPI(nodeApi_->napi_get_value_bigint_words(env_, value, nullptr, &wordCount, nullptr));
-  uint64_t stackWords[8];
-  std::unique_ptr<uint64_t[]> heapWords;
-  uint64_t *words = stackWords;
-  if (wordCount > std::size(stackWords)) {
-    heapWords = std::unique_ptr<uint64_t[]>(new uint64_t[wordCount]);
-    words = heapWords.get();
+bool isLess(const BigIntLimbs &left, const BigIntLimbs &right) noexcept {
+  if (left.size() != right.size()) {
+    return left.size() < right.size();
   }
-  int32_t signBit{};
-  CHECK_NAPI(nodeApi_->napi_get_value_bigint_words(env_, value, &signBit, &wordCount, words));
+  return std::lexicographical_compare(left.rbegin(), left.rend(), right.rbegin(), right.rend());
+}
 
-  if (signBit) {
-    // negate negative numbers, and then add a "-" to the output.
-    // a. flip all bits
-    for (size_t i = 0; i < wordCount; ++i) {
-      words[i] = ~words[i];
+BigIntLimbs multiplyLimbs(const BigIntLimbs &left, const BigIntLimbs &right) {
+  BigIntLimbs result(left.size() + right.size(), 0);
+  for (size_t i = 0; i < left.size(); ++i) {
+    uint64_t carry = 0;
+    for (size_t j = 0; j < right.size(); ++j) {
+      uint64_t product = static_cast<uint64_t>(left[i]) * right[j] + result[i + j] + carry;
+      result[i + j] = static_cast<uint32_t>(product);
+      carry = product >> 32;
     }
-    // b. add 1
-    for (size_t i = 0; i < wordCount; ++i) {
-      if (++words[i] >= 1) {
-        break; // No need to carry so exit early.
+    result[i + right.size()] = static_cast<uint32_t>(carry);
+  }
+  trimLimbs(result);
+  return result;
+}
+
+// Computes the quotient and remainder of the dividend and divisor with the Knuth's algorithm D.
+void divideLimbs(
+    const BigIntLimbs &dividend,
+    const BigIntLimbs &divisor,
+    BigIntLimbs &quotient,
+    BigIntLimbs &remainder) {
+  const size_t m = dividend.size();
+  const size_t n = divisor.size();
+  if (m < n) {
+    quotient.clear();
+    remainder = dividend;
+    return;
+  }
+  if (n == 1) {
+    quotient = dividend;
+    uint32_t smallRemainder = divideLimbs(quotient, divisor[0]);
+    remainder.assign(1, smallRemainder);
+    trimLimbs(remainder);
+    return;
+  }
+
+  // Normalize the operands so that the highest divisor limb has its top bit set.
+  constexpr uint64_t base = uint64_t{1} << 32;
+  const uint32_t shift = countLeadingZeros(divisor[n - 1]);
+  BigIntLimbs normDivisor(n);
+  BigIntLimbs normDividend(m + 1);
+  for (size_t i = n - 1; i > 0; --i) {
+    normDivisor[i] = static_cast<uint32_t>(
+        (static_cast<uint64_t>(divisor[i]) << shift) | ((static_cast<uint64_t>(divisor[i - 1]) << shift) >> 32));
+  }
+  normDivisor[0] = divisor[0] << shift;
+  normDividend[m] = static_cast<uint32_t>((static_cast<uint64_t>(dividend[m - 1]) << shift) >> 32);
+  for (size_t i = m - 1; i > 0; --i) {
+    normDividend[i] = static_cast<uint32_t>(
+        (static_cast<uint64_t>(dividend[i]) << shift) | ((static_cast<uint64_t>(dividend[i - 1]) << shift) >> 32));
+  }
+  normDividend[0] = dividend[0] << shift;
+
+  quotient.assign(m - n + 1, 0);
+  for (size_t j = m - n + 1; j-- > 0;) {
+    // Estimate the quotient limb from the top two dividend limbs and correct it with the next limbs.
+    uint64_t numerator = (static_cast<uint64_t>(normDividend[j + n]) << 32) | normDividend[j + n - 1];
+    uint64_t qhat = numerator / normDivisor[n - 1];
+    uint64_t rhat = numerator % normDivisor[n - 1];
+    while (qhat >= base || qhat * normDivisor[n - 2] > ((rhat << 32) | normDividend[j + n - 2])) {
+      --qhat;
+      rhat += normDivisor[n - 1];
+      if (rhat >= base) {
+        break;
+      }
+    }
+
+    // Multiply and subtract.
+    int64_t borrow = 0;
+    int64_t difference = 0;
+    for (size_t i = 0; i < n; ++i) {
+      uint64_t product = qhat * normDivisor[i];
+      difference = static_cast<int64_t>(normDividend[i + j]) - borrow - static_cast<int64_t>(product & 0xFFFFFFFFu);
+      normDividend[i + j] = static_cast<uint32_t>(difference);
+      borrow = static_cast<int64_t>(product >> 32) - (difference >> 32);
+    }
+    difference = static_cast<int64_t>(normDividend[j + n]) - borrow;
+    normDividend[j + n] = static_cast<uint32_t>(difference);
+
+    // The estimate was one too large. Add the divisor back.
+    if (difference < 0) {
+      --qhat;
+      uint64_t carry = 0;
+      for (size_t i = 0; i < n; ++i) {
+        uint64_t sum = static_cast<uint64_t>(normDividend[i + j]) + normDivisor[i] + carry;
+        normDividend[i + j] = static_cast<uint32_t>(sum);
+        carry = sum >> 32;
       }
+      normDividend[j + n] += static_cast<uint32_t>(carry);
     }
+    quotient[j] = static_cast<uint32_t>(qhat);
   }
+  trimLimbs(quotient);
 
-  if (wordCount == 0) {
-    return createStringFromAscii("0", 1);
+  // Unnormalize the remainder.
+  remainder.resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    remainder[i] = static_cast<uint32_t>(
+        ((static_cast<uint64_t>(normDividend[i + 1]) << 32) | normDividend[i]) >> shift);
   }
+  trimLimbs(remainder);
+}
 
-  // avoid trashing the heap by pre-allocating the largest possible string
-  // returned by this function. The "1" below is to account for a possible "-"
-  // sign.
-  std::string digits;
-  digits.reserve(1 + wordCount * maxCharsPerDigitInRadix(radix));
+// Converts BigInt limbs to digits by dividing them by the largest radix power that fits into a limb.
+class BigIntDigitWriter {
+ public:
+  explicit BigIntDigitWriter(uint32_t radix) noexcept : radix_(radix) {
+    while (chunkDivisor_ <= std::numeric_limits<uint32_t>::max() / radix_) {
+      chunkDivisor_ *= radix_;
+      ++chunkDigitCount_;
+    }
+  }
 
-  // Use 32-bit values for calculations to get 64-bit results.
-  // For the little-endian machines we just cast the words array.
-  // TODO: Add support for big-endian.
-  uint32_t *halfWords = reinterpret_cast<uint32_t *>(words);
-  size_t count = wordCount * 2;
-  for (size_t i = count; i > 0 && halfWords[i - 1] == 0; --i) {
-    --count;
+  // Writes value digits backward ending at the end and returns the first digit position.
+  // If the padTo is not zero, then the digits are padded with zeros up to the padTo digits.
+  char *write(BigIntLimbs value, char *end, size_t padTo) {
+    if (value.size() > BigIntDivideAndConquerThreshold) {
+      size_t level = 0;
+      while (getPower(level).size() <= value.size()) {
+        ++level;
+      }
+      return writeDivideAndConquer(std::move(value), level, end, padTo);
+    }
+    return writeChunked(value, end, padTo);
   }
 
-  uint32_t divisor = static_cast<uint32_t>(radix);
-  uint32_t remainder = 0;
-  uint64_t word0 = words[0];
+ private:
+  // Writes digits of a value that is less than getPower(level).
+  char *writeDivideAndConquer(BigIntLimbs value, size_t level, char *end, size_t padTo) {
+    if (padTo == 0) {
+      // Avoid the leading zeros: the high part must not be empty.
+      while (level > 0 && isLess(value, getPower(level - 1))) {
+        --level;
+      }
+    }
+    if (level == 0 || value.size() <= BigIntDivideAndConquerThreshold) {
+      return writeChunked(value, end, padTo);
+    }
+    BigIntLimbs high;
+    BigIntLimbs low;
+    divideLimbs(value, getPower(level - 1), high, low);
+    size_t lowDigitCount = chunkDigitCount_ << (level - 1);
+    writeDivideAndConquer(std::move(low), level - 1, end, lowDigitCount);
+    return writeDivideAndConquer(
+        std::move(high), level - 1, end - lowDigitCount, padTo > lowDigitCount ? padTo - lowDigitCount : 0);
+  }
 
-  do {
-    // We rewrite the halfWords array as we divide it by radix.
-    if (count <= 2) {
-      remainder = word0 % divisor;
-      word0 = word0 / divisor;
-    } else {
-      for (size_t i = count; i > 0; --i) {
-        uint64_t partialDividend = Make_64(remainder, halfWords[i - 1]);
-        if (partialDividend == 0) {
-          halfWords[i] = 0;
-          remainder = 0;
-          if (i == count) {
-            if (--count == 2) {
-              word0 = words[0];
-            }
-          }
-        } else if (partialDividend < divisor) {
-          halfWords[i] = 0;
-          remainder = Lo_32(partialDividend);
-          if (i == count) {
-            if (--count == 2) {
-              word0 = words[0];
-            }
-          }
-        } else if (partialDividend == divisor) {
-          halfWords[i] = 1;
-          remainder = 0;
-        } else {
-          halfWords[i] = Lo_32(partialDividend / divisor);
-          remainder = Lo_32(partialDividend % divisor);
+  char *writeChunked(BigIntLimbs &value, char *end, size_t padTo) {
+    char *current = end;
+    while (!value.empty()) {
+      uint32_t chunk = divideLimbs(value, chunkDivisor_);
+      if (value.empty()) {
+        do {
+          *--current = BigIntDigitChars[chunk % radix_];
+          chunk /= radix_;
+        } while (chunk != 0);
+      } else {
+        for (uint32_t i = 0; i < chunkDigitCount_; ++i) {
+          *--current = BigIntDigitChars[chunk % radix_];
+          chunk /= radix_;
         }
       }
     }
+    while (static_cast<size_t>(end - current) < padTo) {
+      *--current = '0';
+    }
+    return current;
+  }
 
-    if (remainder < 10) {
-      digits.push_back('0' + remainder);
-    } else {
-      digits.push_back('a' + remainder - 10);
+  // Returns chunkDivisor_^(2^level).
+  const BigIntLimbs &getPower(size_t level) {
+    if (powers_.empty()) {
+      powers_.push_back(BigIntLimbs{chunkDivisor_});
+    }
+    while (powers_.size() <= level) {
+      powers_.push_back(multiplyLimbs(powers_.back(), powers_.back()));
     }
-  } while (count > 2 || word0 != 0);
+    return powers_[level];
+  }
 
-  if (signBit) {
-    digits.push_back('-');
+ private:
+  uint32_t radix_;
+  uint32_t chunkDivisor_{1};
+  uint32_t chunkDigitCount_{0};
+  std::vector<BigIntLimbs> powers_;
+};
+
+// Writes digits of a power of two radix by slicing the value bits.
+char *writeBigIntBitSlices(const BigIntLimbs &value, uint32_t radix, char *end) {
+  uint32_t bitsPerDigit = 31 - countLeadingZeros(radix);
+  size_t bitLength = value.size() * 32 - countLeadingZeros(value.back());
+  size_t digitCount = (bitLength + bitsPerDigit - 1) / bitsPerDigit;
+  char *begin = end - digitCount;
+  char *current = begin;
+  for (size_t digitIndex = digitCount; digitIndex-- > 0;) {
+    size_t bitIndex = digitIndex * bitsPerDigit;
+    size_t limbIndex = bitIndex / 32;
+    uint32_t bitOffset = static_cast<uint32_t>(bitIndex % 32);
+    uint64_t bits = value[limbIndex] >> bitOffset;
+    if (bitOffset + bitsPerDigit > 32 && limbIndex + 1 < value.size()) {
+      bits |= static_cast<uint64_t>(value[limbIndex + 1]) << (32 - bitOffset);
+    }
+    *current++ = BigIntDigitChars[bits & (radix - 1)];
+  }
+  return begin;
+}
+
+jsi::String NodeApiJsiRuntime::bigintToString(const jsi::BigInt &bigint, int32_t radix) {
+  PROFILE_JSI_METHOD();
+  if (radix < 2 || radix > 36) {
+    throw makeJSError("Invalid radix ", radix, " to BigInt.toString");
+  }
+
+  napi_value value = getNodeApiValue(bigint);
+  SmallBuffer<uint64_t, MaxStackArgCount> wordBuffer(getBigIntWordCount(value));
+  bool signBit{};
+  size_t wordCount = readBigIntMagnitude(value, signBit, wordBuffer.data(), wordBuffer.size());
+  const uint64_t *words = wordBuffer.data();
+  if (wordCount == 0) {
+    return createStringFromAscii("0", 1);
+  }
+
+  // Values that fit into 64 bits do not need the multi-limb arithmetic.
+  if (wordCount == 1) {
+    char buffer[66];
+    char *begin = buffer;
+    if (signBit) {
+      *begin++ = '-';
+    }
+    std::to_chars_result result = std::to_chars(begin, std::end(buffer), words[0], radix);
+    return createStringFromAscii(buffer, result.ptr - buffer);
   }
 
-  std::reverse(digits.begin(), digits.end());
-  return createStringFromAscii(digits.data(), digits.size());
+  BigIntLimbs limbs(wordCount * 2);
+  for (size_t i = 0; i < wordCount; ++i) {
+    limbs[i * 2] = static_cast<uint32_t>(words[i]);
+    limbs[i * 2 + 1] = static_cast<uint32_t>(words[i] >> 32);
+  }
+  trimLimbs(limbs);
+
+  // Each digit covers at least floor(log2(radix)) bits. The extra character is for the "-" sign.
+  size_t bitLength = limbs.size() * 32 - countLeadingZeros(limbs.back());
+  size_t maxDigitCount = bitLength / (31 - countLeadingZeros(static_cast<uint32_t>(radix))) + 1;
+  std::unique_ptr<char[]> digits(new char[maxDigitCount + 1]);
+  char *end = digits.get() + maxDigitCount + 1;
+  char *begin = ((radix & (radix - 1)) == 0)
+      ? writeBigIntBitSlices(limbs, static_cast<uint32_t>(radix), end)
+      : BigIntDigitWriter(static_cast<uint32_t>(radix)).write(std::move(limbs), end, 0);
+  if (signBit) {
+    *--begin = '-';
+  }
+  return createStringFromAscii(begin, end - begin);
 }
 
 jsi::String NodeApiJsiRuntime::createStringFromAscii(const char *str, size_t length) {
-  return makeJsiPointer<jsi::String>(createStringLatin1({str, length}));
+  PROFILE_JSI_METHOD();
+  return createInternedString({str, length}, [this, str, length]() { return createStringLatin1({str, length}); });
 }
 
 jsi::String NodeApiJsiRuntime::createStringFromUtf8(const uint8_t *str, size_t length) {
-  return makeJsiPointer<jsi::String>(createStringUtf8(str, length));
+  PROFILE_JSI_METHOD();
+  return createInternedString(
+      {reinterpret_cast<const char *>(str), length}, [this, str, length]() { return createStringUtf8(str, length); });
 }
 
 std::string NodeApiJsiRuntime::utf8(const jsi::String &str) {
+  PROFILE_JSI_METHOD();
   return stringToStdString(getNodeApiValue(str));
 }
 
 jsi::Object NodeApiJsiRuntime::createObject() {
+  PROFILE_JSI_METHOD();
   return makeJsiPointer<jsi::Object>(createNodeApiObject());
 }
 
 jsi::Object NodeApiJsiRuntime::createObject(std::shared_ptr<jsi::HostObject> hostObject) {
+  PROFILE_JSI_METHOD();
   // The hostObjectHolder keeps the hostObject as external data.
   // Then, the hostObjectHolder is wrapped up by a Proxy object to provide access
   // to the hostObject's get, set, and getPropertyNames methods.
@@ -1223,10 +2209,12 @@ jsi::Object NodeApiJsiRuntime::createObject(std::shared_ptr<jsi::HostObject> hos
 }
 
 std::shared_ptr<jsi::HostObject> NodeApiJsiRuntime::getHostObject(const jsi::Object &obj) {
+  PROFILE_JSI_METHOD();
   return getJsiHostObject(getNodeApiValue(obj));
 }
 
 jsi::HostFunctionType &NodeApiJsiRuntime::getHostFunction(const jsi::Function &func) {
+  PROFILE_JSI_METHOD();
   napi_value hostFunctionHolder = getProperty(getNodeApiValue(func), getNodeApiValue((propertyId_.hostFunctionSymbol)));
   if (typeOf(hostFunctionHolder) == napi_valuetype::napi_external) {
     return static_cast<HostFunctionWrapper *>(getExternalData(hostFunctionHolder))->hostFunction();
@@ -1236,12 +2224,14 @@ jsi::HostFunctionType &NodeApiJsiRuntime::getHostFunction(const jsi::Function &f
 }
 
 bool NodeApiJsiRuntime::hasNativeState(const jsi::Object &obj) {
+  PROFILE_JSI_METHOD();
   void *nativeState{};
   napi_status status = nodeApi_->napi_unwrap(env_, getNodeApiValue(obj), &nativeState);
   return status == napi_ok && nativeState != nullptr;
 }
 
 std::shared_ptr<jsi::NativeState> NodeApiJsiRuntime::getNativeState(const jsi::Object &obj) {
+  PROFILE_JSI_METHOD();
   void *nativeState{};
   CHECK_NAPI(nodeApi_->napi_unwrap(env_, getNodeApiValue(obj), &nativeState));
   if (nativeState != nullptr) {
@@ -1252,6 +2242,7 @@ std::shared_ptr<jsi::NativeState> NodeApiJsiRuntime::getNativeState(const jsi::O
 }
 
 void NodeApiJsiRuntime::setNativeState(const jsi::Object &obj, std::shared_ptr<jsi::NativeState> state) {
+  PROFILE_JSI_METHOD();
   if (hasNativeState(obj)) {
     void *nativeState{};
     CHECK_NAPI(nodeApi_->napi_remove_wrap(env_, getNodeApiValue(obj), &nativeState));
@@ -1276,44 +2267,54 @@ void NodeApiJsiRuntime::setNativeState(const jsi::Object &obj, std::shared_ptr<j
 }
 
 jsi::Value NodeApiJsiRuntime::getProperty(const jsi::Object &obj, const jsi::PropNameID &name) {
+  PROFILE_JSI_METHOD();
   return toJsiValue(getProperty(getNodeApiValue(obj), getNodeApiValue(name)));
 }
 
 jsi::Value NodeApiJsiRuntime::getProperty(const jsi::Object &obj, const jsi::String &name) {
+  PROFILE_JSI_METHOD();
   return toJsiValue(getProperty(getNodeApiValue(obj), getNodeApiValue(name)));
 }
 
 bool NodeApiJsiRuntime::hasProperty(const jsi::Object &obj, const jsi::PropNameID &name) {
+  PROFILE_JSI_METHOD();
   return hasProperty(getNodeApiValue(obj), getNodeApiValue(name));
 }
 
 bool NodeApiJsiRuntime::hasProperty(const jsi::Object &obj, const jsi::String &name) {
+  PROFILE_JSI_METHOD();
   return hasProperty(getNodeApiValue(obj), getNodeApiValue(name));
 }
 
 void NodeApiJsiRuntime::setPropertyValue(const jsi::Object &obj, const jsi::PropNameID &name, const jsi::Value &value) {
+  PROFILE_JSI_METHOD();
   setProperty(getNodeApiValue(obj), getNodeApiValue(name), getNodeApiValue(value));
 }
 
 void NodeApiJsiRuntime::setPropertyValue(const jsi::Object &obj, const jsi::String &name, const jsi::Value &value) {
+  PROFILE_JSI_METHOD();
   setProperty(getNodeApiValue(obj), getNodeApiValue(name), getNodeApiValue(value));
 }
 
 bool NodeApiJsiRuntime::isArray(const jsi::Object &obj) const {
+  PROFILE_JSI_METHOD();
   return isArray(getNodeApiValue(obj));
 }
 
 bool NodeApiJsiRuntime::isArrayBuffer(const jsi::Object &obj) const {
+  PROFILE_JSI_METHOD();
   bool result{};
   CHECK_NAPI(nodeApi_->napi_is_arraybuffer(env_, getNodeApiValue(obj), &result));
   return result;
 }
 
 bool NodeApiJsiRuntime::isFunction(const jsi::Object &obj) const {
+  PROFILE_JSI_METHOD();
   return typeOf(getNodeApiValue(obj)) == napi_valuetype::napi_function;
 }
 
 bool NodeApiJsiRuntime::isHostObject(const jsi::Object &obj) const {
+  PROFILE_JSI_METHOD();
   napi_value hostObjectHolder = getProperty(getNodeApiValue(obj), getNodeApiValue(propertyId_.hostObjectSymbol));
   if (typeOf(hostObjectHolder) == napi_valuetype::napi_external) {
     return getExternalData(hostObjectHolder) != nullptr;
@@ -1323,6 +2324,7 @@ bool NodeApiJsiRuntime::isHostObject(const jsi::Object &obj) const {
 }
 
 bool NodeApiJsiRuntime::isHostFunction(const jsi::Function &func) const {
+  PROFILE_JSI_METHOD();
   napi_value hostFunctionHolder = getProperty(getNodeApiValue(func), getNodeApiValue(propertyId_.hostFunctionSymbol));
   if (typeOf(hostFunctionHolder) == napi_valuetype::napi_external) {
     return getExternalData(hostFunctionHolder) != nullptr;
@@ -1332,6 +2334,7 @@ bool NodeApiJsiRuntime::isHostFunction(const jsi::Function &func) const {
 }
 
 jsi::Array NodeApiJsiRuntime::getPropertyNames(const jsi::Object &obj) {
+  PROFILE_JSI_METHOD();
   napi_value properties;
   CHECK_NAPI(nodeApi_->napi_get_all_property_names(
       env_,
@@ -1344,11 +2347,13 @@ jsi::Array NodeApiJsiRuntime::getPropertyNames(const jsi::Object &obj) {
 }
 
 jsi::WeakObject NodeApiJsiRuntime::createWeakObject(const jsi::Object &obj) {
+  PROFILE_JSI_METHOD();
   return make<jsi::WeakObject>(NodeApiRefCountedPointerValue::make(
       *const_cast<NodeApiJsiRuntime *>(this), getNodeApiValue(obj), NodeApiPointerValueKind::WeakObject));
 }
 
 jsi::Value NodeApiJsiRuntime::lockWeakObject(const jsi::WeakObject &weakObject) {
+  PROFILE_JSI_METHOD();
   napi_value value = getNodeApiValue(weakObject);
   if (value) {
     return toJsiValue(value);
@@ -1358,10 +2363,12 @@ jsi::Value NodeApiJsiRuntime::lockWeakObject(const jsi::WeakObject &weakObject)
 }
 
 jsi::Array NodeApiJsiRuntime::createArray(size_t length) {
+  PROFILE_JSI_METHOD();
   return makeJsiPointer<jsi::Object>(createNodeApiArray(length)).asArray(*this);
 }
 
 jsi::ArrayBuffer NodeApiJsiRuntime::createArrayBuffer(std::shared_ptr<jsi::MutableBuffer> buffer) {
+  PROFILE_JSI_METHOD();
   napi_value result{};
   void *data = buffer->data();
   size_t size = buffer->size();
@@ -1379,16 +2386,19 @@ jsi::ArrayBuffer NodeApiJsiRuntime::createArrayBuffer(std::shared_ptr<jsi::Mutab
 }
 
 size_t NodeApiJsiRuntime::size(const jsi::Array &arr) {
+  PROFILE_JSI_METHOD();
   return getArrayLength(getNodeApiValue(arr));
 }
 
 size_t NodeApiJsiRuntime::size(const jsi::ArrayBuffer &arrBuf) {
+  PROFILE_JSI_METHOD();
   size_t result{};
   CHECK_NAPI(nodeApi_->napi_get_arraybuffer_info(env_, getNodeApiValue(arrBuf), nullptr, &result));
   return result;
 }
 
 uint8_t *NodeApiJsiRuntime::data(const jsi::ArrayBuffer &arrBuf) {
+  PROFILE_JSI_METHOD();
   uint8_t *result{};
   CHECK_NAPI(
       nodeApi_->napi_get_arraybuffer_info(env_, getNodeApiValue(arrBuf), reinterpret_cast<void **>(&result), nullptr));
@@ -1396,10 +2406,12 @@ uint8_t *NodeApiJsiRuntime::data(const jsi::ArrayBuffer &arrBuf) {
 }
 
 jsi::Value NodeApiJsiRuntime::getValueAtIndex(const jsi::Array &arr, size_t index) {
+  PROFILE_JSI_METHOD();
   return toJsiValue(getElement(getNodeApiValue(arr), index));
 }
 
 void NodeApiJsiRuntime::setValueAtIndexImpl(const jsi::Array &arr, size_t index, const jsi::Value &value) {
+  PROFILE_JSI_METHOD();
   setElement(getNodeApiValue(arr), static_cast<uint32_t>(index), getNodeApiValue(value));
 }
 
@@ -1407,6 +2419,7 @@ jsi::Function NodeApiJsiRuntime::createFunctionFromHostFunction(
     const jsi::PropNameID &name,
     unsigned int paramCount,
     jsi::HostFunctionType func) {
+  PROFILE_JSI_METHOD();
   auto hostFunctionWrapper = std::make_unique<HostFunctionWrapper>(std::move(func), *this);
   napi_value function = createExternalFunction(
       getNodeApiValue(name), static_cast<int32_t>(paramCount), jsiHostFunctionCallback, hostFunctionWrapper.get());
@@ -1422,11 +2435,13 @@ jsi::Function NodeApiJsiRuntime::createFunctionFromHostFunction(
 
 jsi::Value
 NodeApiJsiRuntime::call(const jsi::Function &func, const jsi::Value &jsThis, const jsi::Value *args, size_t count) {
+  PROFILE_JSI_METHOD();
   return toJsiValue(callFunction(
       getNodeApiValue(jsThis), getNodeApiValue(func), NodeApiValueArgs(*this, span<const jsi::Value>(args, count))));
 }
 
 jsi::Value NodeApiJsiRuntime::callAsConstructor(const jsi::Function &func, const jsi::Value *args, size_t count) {
+  PROFILE_JSI_METHOD();
   return toJsiValue(
       constructObject(getNodeApiValue(func), NodeApiValueArgs(*this, span<jsi::Value const>(args, count))));
 }
@@ -1444,22 +2459,27 @@ void NodeApiJsiRuntime::popScope(jsi::Runtime::ScopeState *state) {
 }
 
 bool NodeApiJsiRuntime::strictEquals(const jsi::Symbol &a, const jsi::Symbol &b) const {
+  PROFILE_JSI_METHOD();
   return strictEquals(getNodeApiValue(a), getNodeApiValue(b));
 }
 
 bool NodeApiJsiRuntime::strictEquals(const jsi::BigInt &a, const jsi::BigInt &b) const {
+  PROFILE_JSI_METHOD();
   return strictEquals(getNodeApiValue(a), getNodeApiValue(b));
 }
 
 bool NodeApiJsiRuntime::strictEquals(const jsi::String &a, const jsi::String &b) const {
+  PROFILE_JSI_METHOD();
   return strictEquals(getNodeApiValue(a), getNodeApiValue(b));
 }
 
 bool NodeApiJsiRuntime::strictEquals(const jsi::Object &a, const jsi::Object &b) const {
+  PROFILE_JSI_METHOD();
   return strictEquals(getNodeApiValue(a), getNodeApiValue(b));
 }
 
 bool NodeApiJsiRuntime::instanceOf(const jsi::Object &obj, const jsi::Function &func) {
+  PROFILE_JSI_METHOD();
   return instanceOf(getNodeApiValue(obj), getNodeApiValue(func));
 }
 
@@ -1573,7 +2593,7 @@ napi_value NodeApiJsiRuntime::NodeApiRefCountedPointerValue::getValue(NodeApiJsi
     return nullptr;
   }
 
-  NodeApi *nodeApi = NodeApi::current();
+  NodeApi *nodeApi = runtime.nodeApi_;
   if (pointerKind_ == NodeApiPointerValueKind::Object || pointerKind_ == NodeApiPointerValueKind::WeakObject) {
     CHECK_NAPI_ELSE_CRASH(nodeApi->napi_get_reference_value(runtime.getEnv(), ref_, &value_));
   } else {
@@ -1640,7 +2660,7 @@ void NodeApiJsiRuntime::NodeApiRefCountedPointerValue::convertToNodeApiRef(NodeA
     NodeApiRefCountedPointerValue *ptr,
     NodeApiJsiRuntime &runtime) noexcept {
   if (ptr != nullptr && ptr->ref_ != nullptr) {
-    CHECK_NAPI_ELSE_CRASH(NodeApi::current()->napi_delete_reference(runtime.getEnv(), ptr->ref_));
+    CHECK_NAPI_ELSE_CRASH(runtime.nodeApi_->napi_delete_reference(runtime.getEnv(), ptr->ref_));
     ptr->ref_ = nullptr;
     ptr->decRefCount();
   }
@@ -1660,7 +2680,7 @@ void NodeApiJsiRuntime::NodeApiRefCountedPointerValue::decRefCount() const noexc
 
 NodeApiJsiRuntime::NodeApiRefCountedPointerValue *NodeApiJsiRuntime::NodeApiRefCountedPointerValue::createNodeApiRef(
     NodeApiJsiRuntime &runtime) {
-  NodeApi *nodeApi = NodeApi::current();
+  NodeApi *nodeApi = runtime.nodeApi_;
   CHECK_ELSE_CRASH(value_ != nullptr, "value_ must not be null");
   CHECK_ELSE_CRASH(ref_ == nullptr, "ref_ must be null");
   if (pointerKind_ == NodeApiPointerValueKind::Object) {
@@ -1723,15 +2743,17 @@ NodeApiJsiRuntime::JsiValueView::operator const jsi::Value &() const noexcept {
 
 /*static*/ jsi::Value
 NodeApiJsiRuntime::JsiValueView::initValue(NodeApiJsiRuntime *runtime, napi_value value, StoreType *store) {
-  switch (runtime->typeOf(value)) {
+  bool boolValue{};
+  double doubleValue{};
+  switch (runtime->getTypeAndValue(value, &boolValue, &doubleValue)) {
     case napi_valuetype::napi_undefined:
       return jsi::Value::undefined();
     case napi_valuetype::napi_null:
       return jsi::Value::null();
     case napi_valuetype::napi_boolean:
-      return jsi::Value{runtime->getValueBool(value)};
+      return jsi::Value{boolValue};
     case napi_valuetype::napi_number:
-      return jsi::Value{runtime->getValueDouble(value)};
+      return jsi::Value{doubleValue};
     case napi_valuetype::napi_string:
       return make<jsi::String>(new (store) NodeApiStackOnlyPointerValue(value, NodeApiPointerValueKind::String));
     case napi_valuetype::napi_symbol:
@@ -1797,11 +2819,47 @@ NodeApiJsiRuntime &NodeApiJsiRuntime::HostFunctionWrapper::runtime() noexcept {
 }
 
 //=====================================================================================================================
-// NodeApiJsiRuntime implementation
+// NodeApiJsiRuntime::LazyPropertyWrapper implementation
 //=====================================================================================================================
 
-template <typename... Args>
-jsi::JSError NodeApiJsiRuntime::makeJSError(Args &&...args) {
+NodeApiJsiRuntime::LazyPropertyWrapper::LazyPropertyWrapper(
+    const jsi::Object &holder,
+    const jsi::PropNameID &name,
+    LazyValueFactory &&factory,
+    NodeApiJsiRuntime &runtime)
+    : holder_{runtime, holder}, name_{runtime, name}, factory_{std::move(factory)}, runtime_{runtime} {}
+
+jsi::Value NodeApiJsiRuntime::LazyPropertyWrapper::createValue() {
+  if (!factory_) {
+    throw jsi::JSINativeException("The lazy property value is already created.");
+  }
+  jsi::Value result = factory_(runtime_);
+  releaseFactory();
+  return result;
+}
+
+void NodeApiJsiRuntime::LazyPropertyWrapper::releaseFactory() noexcept {
+  factory_ = nullptr;
+}
+
+jsi::WeakObject &NodeApiJsiRuntime::LazyPropertyWrapper::holder() noexcept {
+  return holder_;
+}
+
+const jsi::PropNameID &NodeApiJsiRuntime::LazyPropertyWrapper::name() const noexcept {
+  return name_;
+}
+
+NodeApiJsiRuntime &NodeApiJsiRuntime::LazyPropertyWrapper::runtime() noexcept {
+  return runtime_;
+}
+
+//=====================================================================================================================
+// NodeApiJsiRuntime implementation
+//=====================================================================================================================
+
+template <typename... Args>
+jsi::JSError NodeApiJsiRuntime::makeJSError(Args &&...args) {
   std::ostringstream errorStream;
   ((errorStream << std::forward<Args>(args)), ...);
   return jsi::JSError(*this, errorStream.str());
@@ -1815,8 +2873,12 @@ jsi::JSError NodeApiJsiRuntime::makeJSError(Args &&...args) {
   if (!hasPendingJSError_ &&
       (status == napi_pending_exception || instanceOf(jsError, getNodeApiValue(cachedValue_.Error)))) {
     AutoRestore<bool> setValue(const_cast<NodeApiJsiRuntime *>(this)->hasPendingJSError_, true);
-    rewriteErrorMessage(jsError);
-    throw jsi::JSError(*const_cast<NodeApiJsiRuntime *>(this), toJsiValue(jsError));
+    // The jsi::JSError reads the message and stack once. They are read again only if they are rewritten.
+    jsi::JSError error(*const_cast<NodeApiJsiRuntime *>(this), toJsiValue(jsError));
+    if (rewriteErrorMessage(jsError, error)) {
+      throw jsi::JSError(*const_cast<NodeApiJsiRuntime *>(this), toJsiValue(jsError));
+    }
+    throw error;
   } else {
     std::ostringstream errorStream;
     errorStream << "A call to NodeApi returned error code 0x" << std::hex << status << '.';
@@ -1824,48 +2886,60 @@ jsi::JSError NodeApiJsiRuntime::makeJSError(Args &&...args) {
   }
 }
 
+// Returns the result of a NodeApi call that may throw a JS exception.
+// The JS exception is returned as the error instead of being thrown as jsi::JSError.
+JsiResult NodeApiJsiRuntime::makeJsiResult(napi_status status, napi_value result) {
+  if (status == napi_ok) {
+    return JsiResult::success(toJsiValue(result));
+  }
+  if (status != napi_pending_exception) {
+    throwJSException(status);
+  }
+  napi_value jsError{};
+  CHECK_NAPI_ELSE_CRASH(nodeApi_->napi_get_and_clear_last_exception(env_, &jsError));
+  return JsiResult::failure(toJsiValue(jsError));
+}
+
 // Throws jsi::JSINativeException with a message.
 [[noreturn]] void NodeApiJsiRuntime::throwNativeException(char const *errorMessage) const {
   throw jsi::JSINativeException(errorMessage);
 }
 
 // Rewrites error messages to match the JSI unit test expectations.
-void NodeApiJsiRuntime::rewriteErrorMessage(napi_value jsError) const {
-  // The code below must work correctly even if the 'message' getter throws.
-  // In case when it throws, we ignore that exception.
-  napi_value message{};
-  napi_status status = nodeApi_->napi_get_property(env_, jsError, getNodeApiValue(propertyId_.message), &message);
-  if (status != napi_ok) {
-    // If the 'message' property getter throws, then we clear the exception and ignore it.
-    napi_value ignoreJSError{};
-    nodeApi_->napi_get_and_clear_last_exception(env_, &ignoreJSError);
-  } else if (typeOf(message) == napi_string) {
-    // JSI unit tests expect V8- or JSC-like messages for the stack overflow.
-    if (stringToStdString(message) == "Out of stack space") {
-      setProperty(
-          jsError,
-          getNodeApiValue(propertyId_.message),
-          createStringUtf8("RangeError : Maximum call stack size exceeded"sv));
-    }
+// It checks the message and stack that the error has already read, and it returns true if it changes them.
+bool NodeApiJsiRuntime::rewriteErrorMessage(napi_value jsError, const jsi::JSError &error) const {
+  // JSI unit tests expect V8- or JSC-like messages for the stack overflow.
+  bool isStackOverflow = error.getMessage() == "Out of stack space"sv;
+  // JSI unit tests expect URL to be part of the call stack.
+  bool isMissingSourceURL = !sourceURL_.empty() && error.getStack().find(sourceURL_) == std::string::npos;
+  if (!isStackOverflow && !isMissingSourceURL) {
+    return false;
   }
 
-  // Make sure that the call stack has the current URL
-  if (!sourceURL_.empty()) {
-    napi_value stack{};
-    napi_status status = nodeApi_->napi_get_property(env_, jsError, getNodeApiValue(propertyId_.stack), &stack);
-    if (status != napi_ok) {
-      // If the 'stack' property getter throws, then we clear the exception and ignore it.
+  // The code below must work correctly even if the 'message' or 'stack' getter throws.
+  // In case when it throws, we clear the exception and ignore it.
+  bool isRewritten = false;
+  auto rewriteProperty = [&](napi_value propertyId, auto &&makeValue) {
+    napi_value value{};
+    if (nodeApi_->napi_get_property(env_, jsError, propertyId, &value) != napi_ok) {
       napi_value ignoreJSError{};
       nodeApi_->napi_get_and_clear_last_exception(env_, &ignoreJSError);
-    } else if (typeOf(message) == napi_string) {
-      // JSI unit tests expect URL to be part of the call stack.
-      std::string stackStr = stringToStdString(stack);
-      if (stackStr.find(sourceURL_) == std::string::npos) {
-        stackStr += sourceURL_ + '\n' + stackStr;
-        setProperty(jsError, getNodeApiValue(propertyId_.stack), createStringUtf8(stackStr.c_str()));
-      }
+    } else if (typeOf(value) == napi_string) {
+      setProperty(jsError, propertyId, makeValue());
+      isRewritten = true;
     }
+  };
+  if (isStackOverflow) {
+    rewriteProperty(getNodeApiValue(propertyId_.message), [&]() {
+      return createStringUtf8("RangeError : Maximum call stack size exceeded"sv);
+    });
   }
+  if (isMissingSourceURL) {
+    rewriteProperty(getNodeApiValue(propertyId_.stack), [&]() {
+      return createStringUtf8(sourceURL_ + '\n' + error.getStack());
+    });
+  }
+  return isRewritten;
 }
 
 // Evaluates lambda and augments exception messages with the method's name.
@@ -1920,6 +2994,25 @@ napi_valuetype NodeApiJsiRuntime::typeOf(napi_value value) const {
   return result;
 }
 
+// Gets type of the napi_value along with the Boolean or Number value.
+// It is a single call instead of two if JS engine implements the napi_ext_get_type_and_value.
+// Otherwise, it calls napi_typeof and napi_get_value_* directly instead of the default_napi_ext_get_type_and_value
+// that adds an indirect call and the thread-local NodeApi lookup.
+napi_valuetype NodeApiJsiRuntime::getTypeAndValue(napi_value value, bool *boolValue, double *doubleValue) const {
+  napi_valuetype result{};
+  if (hasTypeAndValueFunc_) {
+    CHECK_NAPI(nodeApi_->napi_ext_get_type_and_value(env_, value, &result, boolValue, doubleValue, nullptr));
+    return result;
+  }
+  CHECK_NAPI(nodeApi_->napi_typeof(env_, value, &result));
+  if (result == napi_boolean && boolValue != nullptr) {
+    CHECK_NAPI(nodeApi_->napi_get_value_bool(env_, value, boolValue));
+  } else if (result == napi_number && doubleValue != nullptr) {
+    CHECK_NAPI(nodeApi_->napi_get_value_double(env_, value, doubleValue));
+  }
+  return result;
+}
+
 // Returns true if two napi_values are strict equal per JavaScript rules.
 bool NodeApiJsiRuntime::strictEquals(napi_value left, napi_value right) const {
   bool result{false};
@@ -1929,16 +3022,20 @@ bool NodeApiJsiRuntime::strictEquals(napi_value left, napi_value right) const {
 
 // Gets the napi_value for the JavaScript's undefined value.
 napi_value NodeApiJsiRuntime::getUndefined() const {
-  napi_value result{nullptr};
-  CHECK_NAPI(nodeApi_->napi_get_undefined(env_, &result));
-  return result;
+  return getScopedValue(primitiveValue_.Undefined, [this]() {
+    napi_value result{nullptr};
+    CHECK_NAPI(nodeApi_->napi_get_undefined(env_, &result));
+    return result;
+  });
 }
 
 // Gets the napi_value for the JavaScript's null value.
 napi_value NodeApiJsiRuntime::getNull() const {
-  napi_value result{};
-  CHECK_NAPI(nodeApi_->napi_get_null(env_, &result));
-  return result;
+  return getScopedValue(primitiveValue_.Null, [this]() {
+    napi_value result{};
+    CHECK_NAPI(nodeApi_->napi_get_null(env_, &result));
+    return result;
+  });
 }
 
 // Gets the napi_value for the JavaScript's global object.
@@ -1950,16 +3047,11 @@ napi_value NodeApiJsiRuntime::getGlobal() const {
 
 // Gets the napi_value for the JavaScript's true and false values.
 napi_value NodeApiJsiRuntime::getBoolean(bool value) const {
-  napi_value result{nullptr};
-  CHECK_NAPI(nodeApi_->napi_get_boolean(env_, value, &result));
-  return result;
-}
-
-// Gets value of the Boolean napi_value.
-bool NodeApiJsiRuntime::getValueBool(napi_value value) const {
-  bool result{nullptr};
-  CHECK_NAPI(nodeApi_->napi_get_value_bool(env_, value, &result));
-  return result;
+  return getScopedValue(value ? primitiveValue_.True : primitiveValue_.False, [this, value]() {
+    napi_value result{nullptr};
+    CHECK_NAPI(nodeApi_->napi_get_boolean(env_, value, &result));
+    return result;
+  });
 }
 
 // Creates napi_value with an int32_t value.
@@ -1983,11 +3075,20 @@ napi_value NodeApiJsiRuntime::createDouble(double value) const {
   return result;
 }
 
-// Gets value of the Double napi_value.
-double NodeApiJsiRuntime::getValueDouble(napi_value value) const {
-  double result{0};
-  CHECK_NAPI(nodeApi_->napi_get_value_double(env_, value, &result));
-  return result;
+// Creates napi_value for a number.
+// The int32_t numbers use napi_create_int32 and the small integers are cached.
+napi_value NodeApiJsiRuntime::createNumber(double value) const {
+  if (value >= std::numeric_limits<int32_t>::min() && value <= std::numeric_limits<int32_t>::max()) {
+    const int32_t intValue = static_cast<int32_t>(value);
+    if (intValue == value && !(intValue == 0 && std::signbit(value))) {
+      if (intValue >= MinCachedInt && intValue <= MaxCachedInt) {
+        return getScopedValue(
+            primitiveValue_.SmallInt[intValue - MinCachedInt], [this, intValue]() { return createInt32(intValue); });
+      }
+      return createInt32(intValue);
+    }
+  }
+  return createDouble(value);
 }
 
 // Creates a napi_value string from the extended ASCII symbols that correspond to the Latin1 encoding.
@@ -2000,8 +3101,12 @@ napi_value NodeApiJsiRuntime::createStringLatin1(std::string_view value) const {
 }
 
 // Creates a napi_value string from a UTF-8 string.
+// ASCII strings are created as Latin-1 strings because it is cheaper for engines.
 napi_value NodeApiJsiRuntime::createStringUtf8(std::string_view value) const {
   CHECK_ELSE_THROW(value.data(), "Cannot convert a nullptr to a JS string.");
+  if (isAscii(value.data(), value.size())) {
+    return createStringLatin1(value);
+  }
   napi_value result{};
   CHECK_NAPI(nodeApi_->napi_create_string_utf8(env_, value.data(), value.size(), &result));
   return result;
@@ -2014,19 +3119,193 @@ napi_value NodeApiJsiRuntime::createStringUtf8(const uint8_t *data, size_t lengt
 
 // Gets std::string from the napi_value string.
 std::string NodeApiJsiRuntime::stringToStdString(napi_value stringValue) const {
-  std::string result;
-  CHECK_ELSE_THROW(
-      typeOf(stringValue) == napi_valuetype::napi_string,
-      "Cannot convert a non JS string NodeApi Value to a std::string.");
-  size_t strLength{};
-  CHECK_NAPI(nodeApi_->napi_get_value_string_utf8(env_, stringValue, nullptr, 0, &strLength));
-  result.assign(strLength, '\0');
-  size_t copiedLength{};
-  CHECK_NAPI(nodeApi_->napi_get_value_string_utf8(env_, stringValue, &result[0], result.length() + 1, &copiedLength));
-  CHECK_ELSE_THROW(result.length() == copiedLength, "Unexpected string length");
+  return withStringUtf8(stringValue, [](std::string_view utf8) { return std::string(utf8); });
+}
+
+// Copies string UTF-8 bytes and the null terminator into the buffer and returns the number of copied bytes.
+// It returns the full string length if the buffer is null.
+size_t NodeApiJsiRuntime::getValueStringUtf8(napi_value stringValue, char *buffer, size_t bufferSize) const {
+  size_t length{};
+  napi_status status = nodeApi_->napi_get_value_string_utf8(env_, stringValue, buffer, bufferSize, &length);
+  CHECK_ELSE_THROW(status != napi_string_expected, "Cannot convert a non JS string NodeApi Value to a std::string.");
+  CHECK_NAPI(status);
+  return length;
+}
+
+// Reads string UTF-8 bytes into the buffer and returns their view.
+// The string length is only queried when the string may not fit into the buffer.
+std::string_view NodeApiJsiRuntime::readStringUtf8(napi_value stringValue, std::string &buffer) const {
+  if (buffer.size() < MinUtf8BufferSize) {
+    buffer.resize(MinUtf8BufferSize);
+  }
+  size_t length = getValueStringUtf8(stringValue, buffer.data(), buffer.size());
+  if (length + MaxUtf8SequenceLength >= buffer.size()) {
+    size_t fullLength = getValueStringUtf8(stringValue, nullptr, 0);
+    if (fullLength > length) {
+      buffer.resize(fullLength + 1);
+      length = getValueStringUtf8(stringValue, buffer.data(), buffer.size());
+      CHECK_ELSE_THROW(length == fullLength, "Unexpected string length");
+    }
+  }
+  return std::string_view(buffer.data(), length);
+}
+
+// Copies string UTF-8 bytes without the null terminator into the buffer if they fit and returns the UTF-8 length.
+// The bytes are read into the scratch buffer first because napi_get_value_string_utf8 writes a truncated prefix
+// and the null terminator into the target buffer.
+size_t NodeApiJsiRuntime::copyStringUtf8(napi_value stringValue, char *buffer, size_t bufferSize) const {
+  return withStringUtf8(stringValue, [buffer, bufferSize](std::string_view utf8) {
+    if (utf8.size() <= bufferSize) {
+      std::memcpy(buffer, utf8.data(), utf8.size());
+    }
+    return utf8.size();
+  });
+}
+
+// Calls the action with the string UTF-8 view that is only valid during the call.
+// It uses the runtime scratch buffer unless the buffer is already used by an outer call.
+template <typename TAction>
+std::invoke_result_t<TAction, std::string_view> NodeApiJsiRuntime::withStringUtf8(
+    napi_value stringValue,
+    TAction &&action) const {
+  if (isUtf8BufferInUse_) {
+    std::string buffer;
+    return action(readStringUtf8(stringValue, buffer));
+  }
+
+  struct Utf8BufferUse {
+    const NodeApiJsiRuntime &runtime;
+    ~Utf8BufferUse() {
+      runtime.isUtf8BufferInUse_ = false;
+      if (runtime.utf8Buffer_.size() > MaxRetainedUtf8BufferSize) {
+        std::string().swap(runtime.utf8Buffer_);
+      }
+    }
+  } bufferUse{*this};
+  isUtf8BufferInUse_ = true;
+  return action(readStringUtf8(stringValue, utf8Buffer_));
+}
+
+// Returns a string from the intern cache if it is enabled, or creates a new string.
+template <typename TCreate>
+jsi::String NodeApiJsiRuntime::createInternedString(std::string_view value, TCreate &&create) {
+  StringInternCache &cache = stringInternCache_;
+  if (cache.maxEntryCount == 0 || value.size() > cache.maxStringLength || value.data() == nullptr) {
+    return makeJsiPointer<jsi::String>(create());
+  }
+
+  auto it = cache.index.find(value);
+  if (it != cache.index.end()) {
+    ++cache.stats.hitCount;
+    cache.entries.splice(cache.entries.begin(), cache.entries, it->second);
+    return make<jsi::String>(it->second->ref->clone(*this));
+  }
+
+  ++cache.stats.missCount;
+  if (cache.entries.size() >= cache.maxEntryCount) {
+    evictStringInternCacheEntry();
+  }
+  NodeApiRefHolder stringRef = makeNodeApiRef(create(), NodeApiPointerValueKind::String, 3);
+  jsi::String result = make<jsi::String>(stringRef.get());
+  cache.entries.push_front(StringInternCache::Entry{std::string(value), std::move(stringRef)});
+  cache.index.emplace(cache.entries.front().text, cache.entries.begin());
   return result;
 }
 
+// Removes the least recently used string from the intern cache.
+// The string reference is deleted with other unused references after all jsi::Strings release it.
+void NodeApiJsiRuntime::evictStringInternCacheEntry() {
+  StringInternCache &cache = stringInternCache_;
+  StringInternCache::Entry &entry = cache.entries.back();
+  cache.index.erase(entry.text);
+  addRef(std::move(entry.ref));
+  cache.entries.pop_back();
+  ++cache.stats.evictionCount;
+}
+
+// Returns the number of 64-bit words that Node-API needs to store the BigInt.
+size_t NodeApiJsiRuntime::getBigIntWordCount(napi_value bigint) const {
+  size_t wordCount{};
+  CHECK_NAPI(nodeApi_->napi_get_value_bigint_words(env_, bigint, nullptr, &wordCount, nullptr));
+  return wordCount;
+}
+
+// Reads the BigInt sign and magnitude into words that must fit the getBigIntWordCount result.
+// Returns the magnitude word count without the leading zero words.
+size_t NodeApiJsiRuntime::readBigIntMagnitude(napi_value bigint, bool &isNegative, uint64_t *words, size_t wordCount)
+    const {
+  isNegative = false;
+  if (wordCount == 0) {
+    return 0;
+  }
+
+  int32_t signBit{};
+  CHECK_NAPI(nodeApi_->napi_get_value_bigint_words(env_, bigint, &signBit, &wordCount, words));
+  if (signBit) {
+    // negate negative numbers to get their magnitude.
+    // a. flip all bits
+    for (size_t i = 0; i < wordCount; ++i) {
+      words[i] = ~words[i];
+    }
+    // b. add 1
+    for (size_t i = 0; i < wordCount; ++i) {
+      if (++words[i] >= 1) {
+        break; // No need to carry so exit early.
+      }
+    }
+  }
+
+  while (wordCount > 0 && words[wordCount - 1] == 0) {
+    --wordCount;
+  }
+  isNegative = signBit != 0 && wordCount > 0;
+  return wordCount;
+}
+
+// Returns a script from the prepared script cache or prepares and caches a new script.
+std::shared_ptr<const jsi::PreparedJavaScript> NodeApiJsiRuntime::prepareCachedJavaScript(
+    const std::shared_ptr<const jsi::Buffer> &buffer,
+    const std::string &sourceURL) {
+  PreparedScriptCache &cache = preparedScriptCache_;
+  std::string_view source(reinterpret_cast<const char *>(buffer->data()), buffer->size());
+  size_t sourceHash = std::hash<std::string_view>{}(source);
+  auto range = cache.index.equal_range(sourceHash);
+  for (auto it = range.first; it != range.second; ++it) {
+    const PreparedScriptCache::Entry &entry = *it->second;
+    if (entry.sourceURL == sourceURL &&
+        (entry.source == buffer ||
+         source == std::string_view(reinterpret_cast<const char *>(entry.source->data()), entry.source->size()))) {
+      ++cache.stats.hitCount;
+      cache.entries.splice(cache.entries.begin(), cache.entries, it->second);
+      return entry.script;
+    }
+  }
+
+  ++cache.stats.missCount;
+  std::shared_ptr<const jsi::PreparedJavaScript> script = prepareJavaScript(buffer, sourceURL);
+  if (cache.entries.size() >= cache.maxEntryCount) {
+    evictPreparedScriptCacheEntry();
+  }
+  cache.entries.push_front(PreparedScriptCache::Entry{sourceHash, sourceURL, buffer, script});
+  cache.index.emplace(sourceHash, cache.entries.begin());
+  return script;
+}
+
+// Removes the least recently used script from the prepared script cache.
+void NodeApiJsiRuntime::evictPreparedScriptCacheEntry() {
+  PreparedScriptCache &cache = preparedScriptCache_;
+  auto entryIt = std::prev(cache.entries.end());
+  auto range = cache.index.equal_range(entryIt->sourceHash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == entryIt) {
+      cache.index.erase(it);
+      break;
+    }
+  }
+  cache.entries.pop_back();
+  ++cache.stats.evictionCount;
+}
+
 // Gets or creates a unique string value from an UTF-8 string_view.
 napi_value NodeApiJsiRuntime::getPropertyIdFromName(std::string_view value) const {
   napi_value result{};
@@ -2168,25 +3447,93 @@ void NodeApiJsiRuntime::setElement(napi_value array, uint32_t index, napi_value
   CHECK_NAPI(nodeApi_->napi_set_element(env_, array, index, value));
 }
 
+// Gets array elements starting from the index.
+void NodeApiJsiRuntime::getElements(napi_value array, size_t index, span<napi_value> elements) const {
+  CHECK_ELSE_THROW(
+      index <= std::numeric_limits<uint32_t>::max() - elements.size(), "The array index is out of the uint32 range.");
+  const uint32_t start = static_cast<uint32_t>(index);
+  const uint32_t count = static_cast<uint32_t>(elements.size());
+  CHECK_NAPI(
+      hasGetElementsFunc_ ? nodeApi_->napi_ext_get_elements(env_, array, start, count, elements.data())
+                          : NodeApiDefaults::getElements(nodeApi_, env_, array, start, count, elements.data()));
+}
+
+// Sets array elements starting from the index.
+void NodeApiJsiRuntime::setElements(napi_value array, size_t index, span<napi_value> elements) const {
+  CHECK_ELSE_THROW(
+      index <= std::numeric_limits<uint32_t>::max() - elements.size(), "The array index is out of the uint32 range.");
+  const uint32_t start = static_cast<uint32_t>(index);
+  const uint32_t count = static_cast<uint32_t>(elements.size());
+  CHECK_NAPI(
+      hasSetElementsFunc_ ? nodeApi_->napi_ext_set_elements(env_, array, start, count, elements.data())
+                          : NodeApiDefaults::setElements(nodeApi_, env_, array, start, count, elements.data()));
+}
+
+// Gets array elements in chunks and converts them to values.
+// Each chunk uses its own scope to release the temporary napi_values.
+template <typename T, typename TConvert>
+void NodeApiJsiRuntime::getElementsInChunks(
+    const jsi::Array &arr,
+    size_t index,
+    T *values,
+    size_t count,
+    TConvert &&convert) {
+  std::array<napi_value, ElementChunkSize> elements;
+  for (size_t chunkStart = 0; chunkStart < count; chunkStart += ElementChunkSize) {
+    const size_t chunkSize = std::min(count - chunkStart, ElementChunkSize);
+    NodeApiScope scope{*this};
+    getElements(getNodeApiValue(arr), index + chunkStart, span<napi_value>(elements.data(), chunkSize));
+    for (size_t i = 0; i < chunkSize; ++i) {
+      values[chunkStart + i] = convert(elements[i]);
+    }
+  }
+}
+
+// Converts values to napi_values and sets them as array elements in chunks.
+// Each chunk uses its own scope to release the temporary napi_values.
+template <typename T, typename TConvert>
+void NodeApiJsiRuntime::setElementsInChunks(
+    const jsi::Array &arr,
+    size_t index,
+    const T *values,
+    size_t count,
+    TConvert &&convert) {
+  std::array<napi_value, ElementChunkSize> elements;
+  for (size_t chunkStart = 0; chunkStart < count; chunkStart += ElementChunkSize) {
+    const size_t chunkSize = std::min(count - chunkStart, ElementChunkSize);
+    NodeApiScope scope{*this};
+    for (size_t i = 0; i < chunkSize; ++i) {
+      elements[i] = convert(values[chunkStart + i]);
+    }
+    setElements(getNodeApiValue(arr), index + chunkStart, span<napi_value>(elements.data(), chunkSize));
+  }
+}
+
 // The NAPI external function callback used for the JSI host function implementation.
 /*static*/ napi_value __cdecl NodeApiJsiRuntime::jsiHostFunctionCallback(
     napi_env env,
     napi_callback_info info) noexcept {
+  PROFILE_JSI_METHOD();
+  // The callback data is the only way to find the runtime. Thus, the first call must use the thread-local NodeApi.
+  // It also reads the arguments if they fit into the stack buffer. Other calls use the runtime NodeApi.
   HostFunctionWrapper *hostFuncWrapper{};
-  size_t argc{};
+  napi_value stackArgs[MaxStackArgCount]{};
+  size_t argc{MaxStackArgCount};
+  napi_value thisArg{};
   CHECK_NAPI_ELSE_CRASH(NodeApi::current()->napi_get_cb_info(
-      env, info, &argc, nullptr, nullptr, reinterpret_cast<void **>(&hostFuncWrapper)));
+      env, info, &argc, stackArgs, &thisArg, reinterpret_cast<void **>(&hostFuncWrapper)));
   CHECK_ELSE_CRASH(hostFuncWrapper, "Cannot find the host function");
   NodeApiJsiRuntime &runtime = hostFuncWrapper->runtime();
   NodeApiPointerValueScope scope{runtime};
 
-  return runtime.handleCallbackExceptions([&env, &info, &argc, &runtime, &hostFuncWrapper]() {
-    SmallBuffer<napi_value, MaxStackArgCount> napiArgs(argc);
-    napi_value thisArg{};
-    CHECK_NAPI_ELSE_CRASH(NodeApi::current()->napi_get_cb_info(env, info, &argc, napiArgs.data(), &thisArg, nullptr));
-    CHECK_ELSE_CRASH(napiArgs.size() == argc, "Wrong argument count");
+  return runtime.handleCallbackExceptions([&env, &info, &argc, &stackArgs, &thisArg, &runtime, &hostFuncWrapper]() {
+    SmallBuffer<napi_value, MaxStackArgCount> heapArgs(argc > MaxStackArgCount ? argc : 0);
+    if (argc > MaxStackArgCount) {
+      CHECK_NAPI_ELSE_CRASH(runtime.nodeApi_->napi_get_cb_info(env, info, &argc, heapArgs.data(), nullptr, nullptr));
+      CHECK_ELSE_CRASH(heapArgs.size() == argc, "Wrong argument count");
+    }
     const JsiValueView jsiThisArg{&runtime, thisArg};
-    JsiValueViewArgs jsiArgs(&runtime, span<napi_value>(napiArgs.data(), napiArgs.size()));
+    JsiValueViewArgs jsiArgs(&runtime, span<napi_value>(argc > MaxStackArgCount ? heapArgs.data() : stackArgs, argc));
 
     const jsi::HostFunctionType &hostFunc = hostFuncWrapper->hostFunction();
     return runtime.runInMethodContext("HostFunction", [&hostFunc, &runtime, &jsiThisArg, &jsiArgs]() {
@@ -2201,16 +3548,79 @@ napi_value NodeApiJsiRuntime::createExternalFunction(
     int32_t paramCount,
     napi_callback callback,
     void *callbackData) {
-  std::string funcName = stringToStdString(name);
   napi_value function{};
-  CHECK_NAPI(
-      nodeApi_->napi_create_function(env_, funcName.data(), funcName.length(), callback, callbackData, &function));
+  withStringUtf8(name, [&](std::string_view funcName) {
+    CHECK_NAPI(
+        nodeApi_->napi_create_function(env_, funcName.data(), funcName.size(), callback, callbackData, &function));
+  });
   setProperty(
       function, getNodeApiValue(propertyId_.length), createInt32(paramCount), napi_property_attributes::napi_default);
 
   return function;
 }
 
+// The NAPI getter callback used for the lazy property implementation.
+// It creates the property value and replaces the accessor property with a data property in the holder object.
+/*static*/ napi_value __cdecl NodeApiJsiRuntime::lazyPropertyGetterCallback(
+    napi_env env,
+    napi_callback_info info) noexcept {
+  PROFILE_JSI_METHOD();
+  LazyPropertyWrapper *lazyPropertyWrapper{};
+  size_t argc{};
+  CHECK_NAPI_ELSE_CRASH(NodeApi::current()->napi_get_cb_info(
+      env, info, &argc, nullptr, nullptr, reinterpret_cast<void **>(&lazyPropertyWrapper)));
+  CHECK_ELSE_CRASH(lazyPropertyWrapper, "Cannot find the lazy property");
+  NodeApiJsiRuntime &runtime = lazyPropertyWrapper->runtime();
+  NodeApiPointerValueScope scope{runtime};
+
+  return runtime.handleCallbackExceptions([&runtime, &lazyPropertyWrapper]() {
+    napi_value value = runtime.runInMethodContext("LazyValueFactory", [&runtime, &lazyPropertyWrapper]() {
+      return runtime.getNodeApiValue(lazyPropertyWrapper->createValue());
+    });
+    napi_value holder = runtime.getNodeApiValue(lazyPropertyWrapper->holder());
+    if (holder == nullptr) {
+      throw jsi::JSINativeException("The lazy property holder is already collected.");
+    }
+    runtime.setProperty(
+        holder, runtime.getNodeApiValue(lazyPropertyWrapper->name()), value, napi_default_jsproperty);
+    return value;
+  });
+}
+
+// The NAPI setter callback used for the lazy property implementation.
+// It defines a data property with the assigned value in the target object.
+/*static*/ napi_value __cdecl NodeApiJsiRuntime::lazyPropertySetterCallback(
+    napi_env env,
+    napi_callback_info info) noexcept {
+  PROFILE_JSI_METHOD();
+  LazyPropertyWrapper *lazyPropertyWrapper{};
+  napi_value value{};
+  napi_value thisArg{};
+  size_t argc{1};
+  CHECK_NAPI_ELSE_CRASH(NodeApi::current()->napi_get_cb_info(
+      env, info, &argc, &value, &thisArg, reinterpret_cast<void **>(&lazyPropertyWrapper)));
+  CHECK_ELSE_CRASH(lazyPropertyWrapper, "Cannot find the lazy property");
+  NodeApiJsiRuntime &runtime = lazyPropertyWrapper->runtime();
+  NodeApiPointerValueScope scope{runtime};
+
+  return runtime.handleCallbackExceptions([&runtime, &lazyPropertyWrapper, &value, &thisArg]() {
+    if (value == nullptr) {
+      value = runtime.getUndefined();
+    }
+    runtime.setProperty(
+        thisArg, runtime.getNodeApiValue(lazyPropertyWrapper->name()), value, napi_default_jsproperty);
+    if (runtime.strictEquals(thisArg, runtime.getNodeApiValue(lazyPropertyWrapper->holder()))) {
+      lazyPropertyWrapper->releaseFactory();
+    }
+    return runtime.getUndefined();
+  });
+}
+
+// Deletes the external string buffer holder after the string is garbage collected or copied.
+void __cdecl NodeApiJsiRuntime::deleteBufferCallback(napi_env /*env*/, void * /*data*/, void *hint) noexcept {
+  delete reinterpret_cast<std::shared_ptr<const jsi::Buffer> *>(hint);
+}
+
 // Creates an object that wraps up external data.
 napi_value NodeApiJsiRuntime::createExternalObject(void *data, napi_finalize finalizeCallback) const {
   napi_value result{};
@@ -2234,6 +3644,19 @@ napi_value NodeApiJsiRuntime::createExternalObject(std::unique_ptr<T> &&data) co
   return object;
 }
 
+// Deletes std::unique_ptr data when the object is garbage collected.
+template <typename T>
+void NodeApiJsiRuntime::addFinalizer(napi_value object, std::unique_ptr<T> &&data) const {
+  napi_finalize finalize = [](napi_env /*env*/, void *dataToDestroy, void * /*finalizerHint*/) {
+    // We wrap dataToDestroy in a unique_ptr to avoid calling delete explicitly.
+    std::unique_ptr<T> dataDeleter{static_cast<T *>(dataToDestroy)};
+  };
+  CHECK_NAPI(nodeApi_->napi_add_finalizer(env_, object, data.get(), finalize, nullptr, nullptr));
+
+  // We only call data.release() after the napi_add_finalizer succeeds to avoid memory leaks.
+  data.release();
+}
+
 // Gets external data wrapped by an external object.
 void *NodeApiJsiRuntime::getExternalData(napi_value object) const {
   void *result{};
@@ -2290,6 +3713,7 @@ void NodeApiJsiRuntime::setProxyTrap(napi_value handler, napi_value propertyName
 
 // The host object Proxy 'has' trap implementation.
 napi_value NodeApiJsiRuntime::hostObjectHasTrap(span<napi_value> args) {
+  PROFILE_JSI_METHOD();
   // args[0] - the Proxy target object.
   // args[1] - the name of the property to check.
   napi_value propertyName = args[1];
@@ -2307,6 +3731,7 @@ napi_value NodeApiJsiRuntime::hostObjectHasTrap(span<napi_value> args) {
 
 // The host object Proxy 'get' trap implementation.
 napi_value NodeApiJsiRuntime::hostObjectGetTrap(span<napi_value> args) {
+  PROFILE_JSI_METHOD();
   // args[0] - the Proxy target object.
   // args[1] - the name of the property to set.
   // args[2] - the Proxy object (unused).
@@ -2326,6 +3751,7 @@ napi_value NodeApiJsiRuntime::hostObjectGetTrap(span<napi_value> args) {
 
 // The host object Proxy 'set' trap implementation.
 napi_value NodeApiJsiRuntime::hostObjectSetTrap(span<napi_value> args) {
+  PROFILE_JSI_METHOD();
   // args[0] - the Proxy target object.
   // args[1] - the name of the property to set.
   // args[2] - the new value of the property to set.
@@ -2340,6 +3766,7 @@ napi_value NodeApiJsiRuntime::hostObjectSetTrap(span<napi_value> args) {
 
 // The host object Proxy 'ownKeys' trap implementation.
 napi_value NodeApiJsiRuntime::hostObjectOwnKeysTrap(span<napi_value> args) {
+  PROFILE_JSI_METHOD();
   // args[0] - the Proxy target object.
   napi_value target = args[0];
 
@@ -2432,6 +3859,7 @@ napi_value NodeApiJsiRuntime::hostObjectOwnKeysTrap(span<napi_value> args) {
 
 // The host object Proxy 'getOwnPropertyDescriptor' trap implementation.
 napi_value NodeApiJsiRuntime::hostObjectGetOwnPropertyDescriptorTrap(span<napi_value> args) {
+  PROFILE_JSI_METHOD();
   // args[0] - the Proxy target object.
   // args[1] - the property
   const auto &hostObject = getJsiHostObject(args[0]);
@@ -2461,15 +3889,17 @@ span<const uint8_t> NodeApiJsiRuntime::toSpan(const jsi::Buffer &buffer) {
 
 // Creates jsi::Value from napi_value.
 jsi::Value NodeApiJsiRuntime::toJsiValue(napi_value value) const {
-  switch (typeOf(value)) {
+  bool boolValue{};
+  double doubleValue{};
+  switch (getTypeAndValue(value, &boolValue, &doubleValue)) {
     case napi_valuetype::napi_undefined:
       return jsi::Value::undefined();
     case napi_valuetype::napi_null:
       return jsi::Value::null();
     case napi_valuetype::napi_boolean:
-      return jsi::Value{getValueBool(value)};
+      return jsi::Value{boolValue};
     case napi_valuetype::napi_number:
-      return jsi::Value{getValueDouble(value)};
+      return jsi::Value{doubleValue};
     case napi_valuetype::napi_string:
       return jsi::Value{makeJsiPointer<jsi::String>(value)};
     case napi_valuetype::napi_symbol:
@@ -2493,7 +3923,7 @@ napi_value NodeApiJsiRuntime::getNodeApiValue(const jsi::Value &value) const {
   } else if (value.isBool()) {
     return getBoolean(value.getBool());
   } else if (value.isNumber()) {
-    return createDouble(value.getNumber());
+    return createNumber(value.getNumber());
   } else if (value.isSymbol()) {
     return getNodeApiValue(value.getSymbol(*const_cast<NodeApiJsiRuntime *>(this)));
   } else if (value.isString()) {
@@ -2615,6 +4045,7 @@ void NodeApiJsiRuntime::addRef(NodeApiRefHolder &&refHolder) {
 
 void NodeApiJsiRuntime::pushPointerValueScope() noexcept {
   stackScopes_.push_back(stackValues_.size());
+  stackScopeIds_.push_back(++lastScopeId_);
 }
 
 void NodeApiJsiRuntime::popPointerValueScope() noexcept {
@@ -2623,6 +4054,7 @@ void NodeApiJsiRuntime::popPointerValueScope() noexcept {
   size_t newStackSize = stackScopes_.back();
   auto beginIterator = stackValues_.begin() + newStackSize;
   stackScopes_.pop_back();
+  stackScopeIds_.pop_back();
   std::for_each(beginIterator, stackValues_.end(), [this](NodeApiStackValueHolder &holder) {
     holder->convertToNodeApiRef(*this);
   });
@@ -2643,6 +4075,26 @@ void NodeApiJsiRuntime::collectUnusedStackValues() {
   stackValues_.resize(beginIterator - stackValues_.begin());
 }
 
+// Gets the cached napi_value if its pointer value scope is still open. Otherwise, creates and caches a new one.
+// The napi_values created in outer scopes remain valid in the nested scopes.
+// The values created outside of the runtime scopes are not cached because they belong to a handle scope
+// that the runtime does not control, such as the host scope or an engine callback scope.
+template <typename TCreate>
+napi_value NodeApiJsiRuntime::getScopedValue(ScopedValue &scopedValue, TCreate &&create) const {
+  const size_t scopeDepth = stackScopeIds_.size();
+  if (scopeDepth == 0) {
+    return create();
+  }
+  if (scopedValue.value != nullptr && scopedValue.scopeDepth <= scopeDepth &&
+      stackScopeIds_[scopedValue.scopeDepth - 1] == scopedValue.scopeId) {
+    return scopedValue.value;
+  }
+
+  napi_value result = create();
+  scopedValue = ScopedValue{result, scopeDepth, stackScopeIds_.back()};
+  return result;
+}
+
 void NodeApiJsiRuntime::collectUnusedRefs() noexcept {
   auto usedByJsiPointer = [](NodeApiRefHolder &holder) {
     return NodeApiRefCountedPointerValue::usedByJsiPointer(holder.get());
@@ -2654,6 +4106,330 @@ void NodeApiJsiRuntime::collectUnusedRefs() noexcept {
   refs_.resize(beginIterator - refs_.begin());
 }
 
+//=====================================================================================================================
+// NodeApiDefaults implementation
+//=====================================================================================================================
+
+// It calls napi_get_element for each element.
+napi_status NodeApiDefaults::getElements(
+    NodeApi *nodeApi,
+    napi_env env,
+    napi_value array,
+    uint32_t index,
+    uint32_t count,
+    napi_value *result) {
+  if (count > 0 && result == nullptr) {
+    return napi_invalid_arg;
+  }
+  for (uint32_t i = 0; i < count; ++i) {
+    NAPI_CALL(nodeApi->napi_get_element(env, array, index + i, &result[i]));
+  }
+  return napi_ok;
+}
+
+// It calls napi_set_element for each element.
+napi_status NodeApiDefaults::setElements(
+    NodeApi *nodeApi,
+    napi_env env,
+    napi_value array,
+    uint32_t index,
+    uint32_t count,
+    const napi_value *values) {
+  if (count > 0 && values == nullptr) {
+    return napi_invalid_arg;
+  }
+  for (uint32_t i = 0; i < count; ++i) {
+    NAPI_CALL(nodeApi->napi_set_element(env, array, index + i, values[i]));
+  }
+  return napi_ok;
+}
+
+// It copies the string and calls the finalizeCallback immediately.
+napi_status NodeApiDefaults::createExternalStringLatin1(
+    NodeApi *nodeApi,
+    napi_env env,
+    char *str,
+    size_t length,
+    napi_finalize finalizeCallback,
+    void *finalizeHint,
+    napi_value *result,
+    bool *copied) {
+  NAPI_CALL(nodeApi->napi_create_string_latin1(env, str, length, result));
+  if (copied != nullptr) {
+    *copied = true;
+  }
+  if (finalizeCallback != nullptr) {
+    finalizeCallback(env, str, finalizeHint);
+  }
+  return napi_ok;
+}
+
+// It copies the string and calls the finalizeCallback immediately.
+napi_status NodeApiDefaults::createExternalStringUtf16(
+    NodeApi *nodeApi,
+    napi_env env,
+    char16_t *str,
+    size_t length,
+    napi_finalize finalizeCallback,
+    void *finalizeHint,
+    napi_value *result,
+    bool *copied) {
+  NAPI_CALL(nodeApi->napi_create_string_utf16(env, str, length, result));
+  if (copied != nullptr) {
+    *copied = true;
+  }
+  if (finalizeCallback != nullptr) {
+    finalizeCallback(env, str, finalizeHint);
+  }
+  return napi_ok;
+}
+
+// The longest script that the default prepared scripts try to run as a function.
+// Longer scripts are bundles that run once, and scanning and copying them costs more than parsing them again.
+constexpr size_t MaxFunctionScriptLength = 64 * 1024;
+
+// Returns true if the brackets outside of the comments and string literals are balanced.
+// It makes sure that the script cannot close the `return (` parenthesis early as `1), (2` does.
+// The regular expression and template literals are rejected because they need a full tokenizer to find their ends.
+bool hasBalancedBrackets(std::string_view script) noexcept {
+  std::string closingBrackets;
+  // The slash starts a regular expression at the expression start and after the operators and some keywords.
+  bool canStartRegExp = true;
+  for (size_t pos = 0; pos < script.size();) {
+    char ch = script[pos];
+    if (ch == '"' || ch == '\'') {
+      for (++pos; pos < script.size() && script[pos] != ch; ++pos) {
+        pos += script[pos] == '\\' ? 1 : 0;
+      }
+      if (pos >= script.size()) {
+        return false;
+      }
+      ++pos;
+      canStartRegExp = false;
+    } else if (ch == '`') {
+      return false;
+    } else if (script.compare(pos, 2, "//") == 0) {
+      pos = std::min(script.find('\n', pos), script.size());
+    } else if (script.compare(pos, 2, "/*") == 0) {
+      pos = script.find("*/", pos + 2);
+      if (pos == std::string_view::npos) {
+        return false;
+      }
+      pos += 2;
+    } else if (ch == '/' && canStartRegExp) {
+      return false;
+    } else if (ch == '(' || ch == '[' || ch == '{') {
+      closingBrackets.push_back(ch == '(' ? ')' : ch == '[' ? ']' : '}');
+      canStartRegExp = true;
+      ++pos;
+    } else if (ch == ')' || ch == ']' || ch == '}') {
+      if (closingBrackets.empty() || closingBrackets.back() != ch) {
+        return false;
+      }
+      closingBrackets.pop_back();
+      canStartRegExp = false;
+      ++pos;
+    } else if (std::isalnum(static_cast<unsigned char>(ch)) || ch == '_' || ch == '$' || ch == '.') {
+      size_t end = pos + 1;
+      while (end < script.size() &&
+             (std::isalnum(static_cast<unsigned char>(script[end])) || script[end] == '_' || script[end] == '$')) {
+        ++end;
+      }
+      std::string_view word = script.substr(pos, end - pos);
+      canStartRegExp = false;
+      for (std::string_view keyword :
+           {"await"sv, "case"sv, "delete"sv, "in"sv, "instanceof"sv, "new"sv, "typeof"sv, "void"sv, "yield"sv}) {
+        canStartRegExp = canStartRegExp || word == keyword;
+      }
+      pos = end;
+    } else {
+      canStartRegExp = canStartRegExp || !std::isspace(static_cast<unsigned char>(ch));
+      ++pos;
+    }
+  }
+  return closingBrackets.empty();
+}
+
+// Returns true if running the script as `return (script)` function body gives the same result as running the script.
+// It is true for the scripts that are a single expression statement. Such scripts do not start with the tokens
+// that the expression statements cannot start with, they do not declare variables in the global scope, and their
+// brackets are balanced. The scripts that are not expressions are rejected later by the Function constructor.
+bool canRunPreparedScriptAsFunction(std::string_view script) noexcept {
+  if (script.find("eval") != std::string_view::npos || script.find("arguments") != std::string_view::npos) {
+    return false; // Direct eval and the arguments object behave differently inside of a function.
+  }
+  size_t pos = 0;
+  while (pos < script.size()) {
+    if (std::isspace(static_cast<unsigned char>(script[pos]))) {
+      ++pos;
+    } else if (script.compare(pos, 2, "//") == 0) {
+      pos = script.find('\n', pos);
+    } else if (script.compare(pos, 2, "/*") == 0) {
+      pos = script.find("*/", pos + 2);
+      pos = pos == std::string_view::npos ? pos : pos + 2;
+    } else {
+      break;
+    }
+  }
+  if (pos >= script.size() || script[pos] == '{') {
+    return false;
+  }
+  for (std::string_view keyword : {"function"sv, "class"sv, "async"sv, "let"sv}) {
+    if (script.compare(pos, keyword.size(), keyword) == 0 &&
+        (pos + keyword.size() == script.size() ||
+         !(std::isalnum(static_cast<unsigned char>(script[pos + keyword.size()])) ||
+           script[pos + keyword.size()] == '_' || script[pos + keyword.size()] == '$'))) {
+      return false;
+    }
+  }
+  return hasBalancedBrackets(script.substr(pos));
+}
+
+// It returns napi_ref as a napi_ext_prepared_script that wraps up an object with a "script" property string
+// and an optional "sourceURL" property string. The "function" property is set to null if the script cannot run as a
+// function. It is checked here on the script bytes before the buffer is finalized or referenced by the string.
+napi_status NodeApiDefaults::createPreparedScript(
+    NodeApi *nodeApi,
+    bool hasExternalStringLatin1,
+    napi_env env,
+    uint8_t *scriptData,
+    size_t scriptLength,
+    napi_finalize finalizeCallback,
+    void *finalizeHint,
+    const char *sourceURL,
+    napi_ext_prepared_script *result) {
+  napi_value script{}, obj{};
+  char *scriptChars = reinterpret_cast<char *>(scriptData);
+  bool canRunAsFunction = scriptLength <= MaxFunctionScriptLength &&
+      canRunPreparedScriptAsFunction(std::string_view(scriptChars, scriptLength));
+  if (isAscii(scriptChars, scriptLength)) {
+    // The ASCII script string references the buffer without copying it if the JS engine supports external strings.
+    // The finalizeCallback is called after the string is collected or copied.
+    napi_status status = hasExternalStringLatin1
+        ? nodeApi->node_api_create_external_string_latin1(
+              env, scriptChars, scriptLength, finalizeCallback, finalizeHint, &script, nullptr)
+        : createExternalStringLatin1(
+              nodeApi, env, scriptChars, scriptLength, finalizeCallback, finalizeHint, &script, nullptr);
+    if (status != napi_ok) {
+      // The failed call does not take the ownership of the buffer.
+      finalizeCallback(env, scriptData, finalizeHint);
+      return status;
+    }
+  } else {
+    // Do not use NAPI_CALL - we must finalize the buffer right after we attempted the string creation.
+    napi_status status = nodeApi->napi_create_string_utf8(env, scriptChars, scriptLength, &script);
+    finalizeCallback(env, scriptData, finalizeHint);
+    NAPI_CALL(status);
+  }
+  NAPI_CALL(nodeApi->napi_create_object(env, &obj));
+  NAPI_CALL(nodeApi->napi_set_named_property(env, obj, "script", script));
+  if (sourceURL != nullptr && sourceURL[0] != '\0') {
+    napi_value sourceURLValue{};
+    NAPI_CALL(nodeApi->napi_create_string_utf8(env, sourceURL, NAPI_AUTO_LENGTH, &sourceURLValue));
+    NAPI_CALL(nodeApi->napi_set_named_property(env, obj, "sourceURL", sourceURLValue));
+  }
+  if (!canRunAsFunction) {
+    napi_value null{};
+    NAPI_CALL(nodeApi->napi_get_null(env, &null));
+    NAPI_CALL(nodeApi->napi_set_named_property(env, obj, "function", null));
+  }
+  return nodeApi->napi_create_reference(env, obj, 1, reinterpret_cast<napi_ref *>(result));
+}
+
+// It deletes the preparedScript as a napi_ref.
+napi_status
+NodeApiDefaults::deletePreparedScript(NodeApi *nodeApi, napi_env env, napi_ext_prepared_script preparedScript) {
+  return nodeApi->napi_delete_reference(env, reinterpret_cast<napi_ref>(preparedScript));
+}
+
+// Compiles the prepared script into a function that returns the script completion value.
+// It is called only for the scripts that createPreparedScript found eligible to run as a function.
+// The result is null if the script is not an expression. The result is cached in the "function" property.
+// The script starts on the same line as the `return (` prefix. The error stack columns of the first script line are
+// shifted by the prefix length, and the line numbers are shifted by the lines that the Function constructor adds
+// before the body if the JS engine adds them.
+napi_status compilePreparedScriptFunction(
+    NodeApi *nodeApi,
+    napi_env env,
+    napi_value obj,
+    napi_value functionConstructor,
+    napi_value *result) {
+  napi_value script{}, sourceURL{};
+  NAPI_CALL(nodeApi->napi_get_named_property(env, obj, "script", &script));
+  NAPI_CALL(nodeApi->napi_get_named_property(env, obj, "sourceURL", &sourceURL));
+
+  constexpr std::string_view prefix = "return (";
+  size_t scriptLength{};
+  NAPI_CALL(nodeApi->napi_get_value_string_utf8(env, script, nullptr, 0, &scriptLength));
+  std::string body(prefix.size() + scriptLength, '\0');
+  std::copy(prefix.begin(), prefix.end(), body.begin());
+  NAPI_CALL(nodeApi->napi_get_value_string_utf8(
+      env, script, body.data() + prefix.size(), scriptLength + 1, &scriptLength));
+
+  NAPI_CALL(nodeApi->napi_get_null(env, result));
+
+  // The line break ends a possible single line comment at the end of the script.
+  body += "\n)";
+  napi_valuetype sourceURLType{};
+  NAPI_CALL(nodeApi->napi_typeof(env, sourceURL, &sourceURLType));
+  if (sourceURLType == napi_string) {
+    size_t sourceURLLength{};
+    NAPI_CALL(nodeApi->napi_get_value_string_utf8(env, sourceURL, nullptr, 0, &sourceURLLength));
+    std::string sourceURLText(sourceURLLength, '\0');
+    NAPI_CALL(nodeApi->napi_get_value_string_utf8(
+        env, sourceURL, sourceURLText.data(), sourceURLLength + 1, &sourceURLLength));
+    body += "\n//# sourceURL=" + sourceURLText;
+  }
+
+  napi_value bodyValue{}, function{};
+  if (functionConstructor == nullptr) {
+    napi_value global{};
+    NAPI_CALL(nodeApi->napi_get_global(env, &global));
+    NAPI_CALL(nodeApi->napi_get_named_property(env, global, "Function", &functionConstructor));
+  }
+  NAPI_CALL(nodeApi->napi_create_string_utf8(env, body.data(), body.size(), &bodyValue));
+  napi_status status = nodeApi->napi_new_instance(env, functionConstructor, 1, &bodyValue, &function);
+  if (status == napi_ok) {
+    *result = function;
+  } else if (status == napi_pending_exception) {
+    // The script is not an expression.
+    napi_value error{};
+    NAPI_CALL(nodeApi->napi_get_and_clear_last_exception(env, &error));
+  } else {
+    return status;
+  }
+  return nodeApi->napi_set_named_property(env, obj, "function", *result);
+}
+
+// It interprets the preparedScript as a napi_ref to an object with a "script" property string.
+// The first run compiles an expression script into a function, and the next runs only call the function.
+// Other scripts are parsed on each run by napi_run_script.
+napi_status NodeApiDefaults::runPreparedScript(
+    NodeApi *nodeApi,
+    napi_env env,
+    napi_ext_prepared_script preparedScript,
+    napi_value functionConstructor,
+    napi_value *result) {
+  napi_value obj{}, function{};
+  NAPI_CALL(nodeApi->napi_get_reference_value(env, reinterpret_cast<napi_ref>(preparedScript), &obj));
+  NAPI_CALL(nodeApi->napi_get_named_property(env, obj, "function", &function));
+  napi_valuetype functionType{};
+  NAPI_CALL(nodeApi->napi_typeof(env, function, &functionType));
+  if (functionType == napi_undefined) {
+    NAPI_CALL(compilePreparedScriptFunction(nodeApi, env, obj, functionConstructor, &function));
+    NAPI_CALL(nodeApi->napi_typeof(env, function, &functionType));
+  }
+
+  if (functionType == napi_function) {
+    napi_value global{};
+    NAPI_CALL(nodeApi->napi_get_global(env, &global));
+    return nodeApi->napi_call_function(env, global, function, 0, nullptr, result);
+  }
+  napi_value script{};
+  NAPI_CALL(nodeApi->napi_get_named_property(env, obj, "script", &script));
+  return nodeApi->napi_run_script(env, script, result);
+}
+
 } // namespace
 
 std::unique_ptr<jsi::Runtime>
@@ -2661,6 +4437,10 @@ makeNodeApiJsiRuntime(napi_env env, NodeApi *nodeApi, std::function<void()> onDe
   return std::make_unique<NodeApiJsiRuntime>(env, nodeApi, std::move(onDelete));
 }
 
+INodeApiJsiRuntime *getNodeApiJsiRuntime(jsi::Runtime &runtime) noexcept {
+  return dynamic_cast<NodeApiJsiRuntime *>(&runtime);
+}
+
 } // namespace Microsoft::NodeApiJsi
 
 EXTERN_C_START
@@ -2706,46 +4486,130 @@ napi_status NAPI_CDECL default_napi_ext_is_inspectable(napi_env /*env*/, bool *r
   return napi_ok;
 }
 
-// TODO: Ensure that we either load all three functions or use their default versions and never mix and match.
+// Default implementation of napi_ext_get_type_and_value if it is not provided by JS engine.
+// It calls napi_typeof and then the napi_get_value_* function for the requested primitive value.
+napi_status NAPI_CDECL default_napi_ext_get_type_and_value(
+    napi_env env,
+    napi_value value,
+    napi_valuetype *result_type,
+    bool *bool_value,
+    double *double_value,
+    size_t *string_length) {
+  Microsoft::NodeApiJsi::NodeApi *nodeApi = Microsoft::NodeApiJsi::NodeApi::current();
+  if (result_type == nullptr) {
+    return napi_invalid_arg;
+  }
+  NAPI_CALL(nodeApi->napi_typeof(env, value, result_type));
+  if (*result_type == napi_boolean && bool_value != nullptr) {
+    return nodeApi->napi_get_value_bool(env, value, bool_value);
+  } else if (*result_type == napi_number && double_value != nullptr) {
+    return nodeApi->napi_get_value_double(env, value, double_value);
+  } else if (*result_type == napi_string && string_length != nullptr) {
+    return nodeApi->napi_get_value_string_utf8(env, value, nullptr, 0, string_length);
+  }
+  return napi_ok;
+}
+
+// Default implementation of napi_ext_get_elements if it is not provided by JS engine.
+napi_status NAPI_CDECL
+default_napi_ext_get_elements(napi_env env, napi_value array, uint32_t index, uint32_t count, napi_value *result) {
+  return Microsoft::NodeApiJsi::NodeApiDefaults::getElements(
+      Microsoft::NodeApiJsi::NodeApi::current(), env, array, index, count, result);
+}
+
+// Default implementation of napi_ext_set_elements if it is not provided by JS engine.
+napi_status NAPI_CDECL
+default_napi_ext_set_elements(napi_env env, napi_value array, uint32_t index, uint32_t count, const napi_value *values) {
+  return Microsoft::NodeApiJsi::NodeApiDefaults::setElements(
+      Microsoft::NodeApiJsi::NodeApi::current(), env, array, index, count, values);
+}
+
+// Default implementation of node_api_create_external_string_latin1 if it is not provided by JS engine.
+napi_status NAPI_CDECL default_node_api_create_external_string_latin1(
+    napi_env env,
+    char *str,
+    size_t length,
+    napi_finalize finalize_callback,
+    void *finalize_hint,
+    napi_value *result,
+    bool *copied) {
+  return Microsoft::NodeApiJsi::NodeApiDefaults::createExternalStringLatin1(
+      Microsoft::NodeApiJsi::NodeApi::current(), env, str, length, finalize_callback, finalize_hint, result, copied);
+}
+
+// Default implementation of node_api_create_external_string_utf16 if it is not provided by JS engine.
+napi_status NAPI_CDECL default_node_api_create_external_string_utf16(
+    napi_env env,
+    char16_t *str,
+    size_t length,
+    napi_finalize finalize_callback,
+    void *finalize_hint,
+    napi_value *result,
+    bool *copied) {
+  return Microsoft::NodeApiJsi::NodeApiDefaults::createExternalStringUtf16(
+      Microsoft::NodeApiJsi::NodeApi::current(), env, str, length, finalize_callback, finalize_hint, result, copied);
+}
+
+// Default implementation of napi_ext_compile_script if it is not provided by JS engine.
+// It reports that the engine cannot compile scripts outside of the JS thread.
+napi_status NAPI_CDECL default_napi_ext_compile_script(
+    const uint8_t * /*script_data*/,
+    size_t /*script_length*/,
+    const char * /*source_url*/,
+    napi_ext_compiled_script *result) {
+  if (result != nullptr) {
+    *result = nullptr;
+  }
+  return napi_generic_failure;
+}
+
+// Default implementation of napi_ext_create_prepared_script_from_compiled if it is not provided by JS engine.
+// There are no compiled scripts to create the prepared script from.
+napi_status NAPI_CDECL default_napi_ext_create_prepared_script_from_compiled(
+    napi_env /*env*/,
+    napi_ext_compiled_script /*compiled_script*/,
+    napi_ext_prepared_script * /*result*/) {
+  return napi_generic_failure;
+}
+
+// Default implementation of napi_ext_delete_compiled_script if it is not provided by JS engine.
+// There are no compiled scripts to delete.
+napi_status NAPI_CDECL default_napi_ext_delete_compiled_script(napi_ext_compiled_script /*compiled_script*/) {
+  return napi_ok;
+}
 
 // Default implementation of napi_ext_create_prepared_script if it is not provided by JS engine.
-// It return napi_ref as a napi_ext_prepared_script that wraps up an object with a "script" property string.
 napi_status NAPI_CDECL default_napi_ext_create_prepared_script(
     napi_env env,
     uint8_t *script_data,
     size_t script_length,
     napi_finalize finalize_cb,
     void *finalize_hint,
-    const char * /*source_url*/,
+    const char *source_url,
     napi_ext_prepared_script *result) {
-  Microsoft::NodeApiJsi::NodeApi *nodeApi = Microsoft::NodeApiJsi::NodeApi::current();
-  napi_value script{}, obj{};
-  // Do not use NAPI_CALL - we must finalize the buffer right after we attempted the string creation.
-  napi_status status =
-      nodeApi->napi_create_string_utf8(env, reinterpret_cast<char *>(script_data), script_length, &script);
-  finalize_cb(env, script_data, finalize_hint);
-  NAPI_CALL(status);
-  NAPI_CALL(nodeApi->napi_create_object(env, &obj));
-  NAPI_CALL(nodeApi->napi_set_named_property(env, obj, "script", script));
-  return nodeApi->napi_create_reference(env, obj, 1, reinterpret_cast<napi_ref *>(result));
+  return Microsoft::NodeApiJsi::NodeApiDefaults::createPreparedScript(
+      Microsoft::NodeApiJsi::NodeApi::current(),
+      true,
+      env,
+      script_data,
+      script_length,
+      finalize_cb,
+      finalize_hint,
+      source_url,
+      result);
 }
 
 // Default implementation of napi_ext_delete_prepared_script if it is not provided by JS engine.
-// It deletes prepared_script as a napi_ref.
 napi_status NAPI_CDECL default_napi_ext_delete_prepared_script(napi_env env, napi_ext_prepared_script prepared_script) {
-  Microsoft::NodeApiJsi::NodeApi *nodeApi = Microsoft::NodeApiJsi::NodeApi::current();
-  return nodeApi->napi_delete_reference(env, reinterpret_cast<napi_ref>(prepared_script));
+  return Microsoft::NodeApiJsi::NodeApiDefaults::deletePreparedScript(
+      Microsoft::NodeApiJsi::NodeApi::current(), env, prepared_script);
 }
 
 // Default implementation of napi_ext_prepared_script_run if it is not provided by JS engine.
-// It interprets prepared_script as a napi_ref to an object with a "script" property string.
 napi_status NAPI_CDECL
 default_napi_ext_prepared_script_run(napi_env env, napi_ext_prepared_script prepared_script, napi_value *result) {
-  Microsoft::NodeApiJsi::NodeApi *nodeApi = Microsoft::NodeApiJsi::NodeApi::current();
-  napi_value obj{}, script{};
-  NAPI_CALL(nodeApi->napi_get_reference_value(env, reinterpret_cast<napi_ref>(prepared_script), &obj));
-  NAPI_CALL(nodeApi->napi_get_named_property(env, obj, "script", &script));
-  return nodeApi->napi_run_script(env, script, result);
+  return Microsoft::NodeApiJsi::NodeApiDefaults::runPreparedScript(
+      Microsoft::NodeApiJsi::NodeApi::current(), env, prepared_script, nullptr, result);
 }
 
 EXTERN_C_END
\ No newline at end of file
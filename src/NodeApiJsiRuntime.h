@@ -7,14 +7,239 @@
 
 #include <jsi/jsi.h>
 #include <napi/js_native_ext_api.h>
+#include <exception>
 #include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include "NodeApi.h"
 
 namespace Microsoft::NodeApiJsi {
 
+// Result of the INodeApiJsiRuntime try* methods. It holds either the returned value or the thrown JS value.
+class JsiResult {
+ public:
+  static JsiResult success(facebook::jsi::Value value) noexcept {
+    return JsiResult(std::move(value), false);
+  }
+
+  static JsiResult failure(facebook::jsi::Value error) noexcept {
+    return JsiResult(std::move(error), true);
+  }
+
+  bool hasValue() const noexcept {
+    return !hasError_;
+  }
+
+  explicit operator bool() const noexcept {
+    return !hasError_;
+  }
+
+  // Returns the returned value. It must be called only if hasValue() is true.
+  facebook::jsi::Value &value() noexcept {
+    assert(!hasError_);
+    return value_;
+  }
+
+  const facebook::jsi::Value &value() const noexcept {
+    assert(!hasError_);
+    return value_;
+  }
+
+  // Returns the thrown JS value. It must be called only if hasValue() is false.
+  facebook::jsi::Value &error() noexcept {
+    assert(hasError_);
+    return value_;
+  }
+
+  const facebook::jsi::Value &error() const noexcept {
+    assert(hasError_);
+    return value_;
+  }
+
+  // Returns the value or throws the JS value as jsi::JSError.
+  facebook::jsi::Value valueOrThrow(facebook::jsi::Runtime &runtime) && {
+    if (hasError_) {
+      throw facebook::jsi::JSError(runtime, std::move(value_));
+    }
+    return std::move(value_);
+  }
+
+ private:
+  JsiResult(facebook::jsi::Value value, bool hasError) noexcept : value_(std::move(value)), hasError_(hasError) {}
+
+ private:
+  facebook::jsi::Value value_;
+  bool hasError_;
+};
+
+// Node-API JSI runtime functionality that is not part of the jsi::Runtime interface.
+struct INodeApiJsiRuntime {
+  // Creates property value on the first property access.
+  using LazyValueFactory = std::function<facebook::jsi::Value(facebook::jsi::Runtime &)>;
+
+  // Defines a configurable and enumerable accessor property that calls the factory on the first access.
+  // Then, the accessor is replaced with a writable data property that holds the factory result.
+  // Assigning the property before the first access replaces the accessor without calling the factory.
+  virtual void defineLazyProperty(
+      const facebook::jsi::Object &obj,
+      const facebook::jsi::PropNameID &name,
+      LazyValueFactory factory) = 0;
+
+  // Gets count array elements starting from the index into the values buffer.
+  virtual void
+  getValuesAtIndex(const facebook::jsi::Array &arr, size_t index, facebook::jsi::Value *values, size_t count) = 0;
+  // Gets count array Number elements starting from the index. Throws if an element is not a Number.
+  virtual void getValuesAtIndex(const facebook::jsi::Array &arr, size_t index, double *values, size_t count) = 0;
+  // The int32_t values are converted the same way as napi_get_value_int32: fractional numbers are truncated
+  // toward zero, and the numbers out of the int32_t range wrap around.
+  virtual void getValuesAtIndex(const facebook::jsi::Array &arr, size_t index, int32_t *values, size_t count) = 0;
+  // Gets count array String elements starting from the index as UTF-8. Throws if an element is not a String.
+  virtual void getValuesAtIndex(const facebook::jsi::Array &arr, size_t index, std::string *values, size_t count) = 0;
+
+  // Sets count array elements starting from the index.
+  virtual void setValuesAtIndex(
+      const facebook::jsi::Array &arr,
+      size_t index,
+      const facebook::jsi::Value *values,
+      size_t count) = 0;
+  virtual void setValuesAtIndex(const facebook::jsi::Array &arr, size_t index, const double *values, size_t count) = 0;
+  virtual void setValuesAtIndex(const facebook::jsi::Array &arr, size_t index, const int32_t *values, size_t count) = 0;
+  // Sets count array elements starting from the index to Strings created from the UTF-8 values.
+  virtual void
+  setValuesAtIndex(const facebook::jsi::Array &arr, size_t index, const std::string_view *values, size_t count) = 0;
+
+  // Gets count property values of the object. The object and property names are resolved once for the batch.
+  virtual void getProperties(
+      const facebook::jsi::Object &obj,
+      const facebook::jsi::PropNameID *names,
+      facebook::jsi::Value *values,
+      size_t count) = 0;
+
+  // Defines count writable, enumerable, and configurable own data properties of the object in one call.
+  // Unlike jsi::Object::setProperty it does not invoke setters and replaces existing configurable properties.
+  virtual void setProperties(
+      const facebook::jsi::Object &obj,
+      const facebook::jsi::PropNameID *names,
+      const facebook::jsi::Value *values,
+      size_t count) = 0;
+
+  // Returns PropNameIDs created from the UTF-8 names and cached in the runtime until it is destroyed.
+  // The cache key is the names array address. It must be a static array with the same count for all calls.
+  virtual const facebook::jsi::PropNameID *getCachedPropNameIDs(const char *const *names, size_t count) = 0;
+
+  // Receives a temporary UTF-8 view of a string that is only valid during the call.
+  using Utf8Callback = void (*)(void *context, std::string_view utf8);
+
+  // Calls the callback with the string UTF-8 view without allocating a std::string.
+  virtual void getUtf8(const facebook::jsi::String &str, void *context, Utf8Callback callback) = 0;
+  virtual void getUtf8(const facebook::jsi::PropNameID &name, void *context, Utf8Callback callback) = 0;
+
+  // Copies the string UTF-8 bytes without the null terminator into the buffer if they fit.
+  // Returns the UTF-8 length. The buffer is not changed if the length is greater than the bufferSize.
+  virtual size_t copyUtf8(const facebook::jsi::String &str, char *buffer, size_t bufferSize) = 0;
+  virtual size_t copyUtf8(const facebook::jsi::PropNameID &name, char *buffer, size_t bufferSize) = 0;
+
+  // Creates a string from the UTF-8 buffer that is kept alive until the string is garbage collected.
+  // ASCII strings reference the buffer without copying if the engine supports external strings.
+  virtual facebook::jsi::String createExternalStringFromUtf8(
+      const std::shared_ptr<const facebook::jsi::Buffer> &buffer) = 0;
+  // Creates a string from the UTF-16 buffer that is kept alive until the string is garbage collected.
+  // The string references the buffer without copying if the engine supports external strings.
+  virtual facebook::jsi::String createExternalStringFromUtf16(
+      const std::shared_ptr<const facebook::jsi::Buffer> &buffer) = 0;
+
+  // Creates a string from UTF-16 code units without transcoding them.
+  virtual facebook::jsi::String createStringFromUtf16(const char16_t *utf16, size_t length) = 0;
+  // Returns the string UTF-16 code units without transcoding them.
+  virtual std::u16string utf16(const facebook::jsi::String &str) = 0;
+
+  // Counters of the string intern cache.
+  struct StringInternCacheStats {
+    uint64_t hitCount;
+    uint64_t missCount;
+    uint64_t evictionCount;
+    size_t entryCount;
+  };
+
+  // Enables the cache of strings created by createStringFromAscii and createStringFromUtf8.
+  // The strings that are not longer than maxStringLength are shared by content.
+  // The cache keeps up to maxEntryCount recently used strings. Zero maxEntryCount disables the cache.
+  virtual void enableStringInternCache(size_t maxEntryCount, size_t maxStringLength) = 0;
+  virtual StringInternCacheStats getStringInternCacheStats() = 0;
+
+  // Counters of the prepared script cache.
+  struct PreparedScriptCacheStats {
+    uint64_t hitCount;
+    uint64_t missCount;
+    uint64_t evictionCount;
+    size_t entryCount;
+  };
+
+  // Enables the cache of scripts prepared by evaluateJavaScript. The scripts are matched by the source content
+  // and the source URL. The cache keeps up to maxEntryCount recently used scripts.
+  // Zero maxEntryCount disables the cache.
+  virtual void enablePreparedScriptCache(size_t maxEntryCount) = 0;
+  virtual PreparedScriptCacheStats getPreparedScriptCacheStats() = 0;
+
+  // Runs the task on the JS thread.
+  using JSThreadDispatcher = std::function<void(std::function<void()> task)>;
+  // Receives the prepared script or the error on the JS thread.
+  using PrepareJavaScriptCallback =
+      std::function<void(std::shared_ptr<const facebook::jsi::PreparedJavaScript> script, std::exception_ptr error)>;
+
+  // Compiles the script on a background thread and calls the callback with the prepared script through the
+  // dispatcher. If the JS engine cannot compile scripts outside of the JS thread, then the script is compiled
+  // synchronously and the callback is called before the method returns.
+  // The background compilation requires the napi_ext_compile_script, napi_ext_create_prepared_script_from_compiled,
+  // and the prepared script functions. No current JS engine exports the first two, including the Hermes package used
+  // by this repo, and this method is synchronous with them.
+  // The runtime compiles the scripts one by one on its own thread. The runtime deletion skips the queued scripts
+  // and waits for the running compilation. The callback is not called if the runtime is deleted before the
+  // dispatched task runs.
+  virtual void prepareJavaScriptAsync(
+      const std::shared_ptr<const facebook::jsi::Buffer> &buffer,
+      std::string sourceURL,
+      JSThreadDispatcher dispatcher,
+      PrepareJavaScriptCallback callback) = 0;
+
+  // The try* methods return the JS exceptions in the JsiResult instead of throwing jsi::JSError.
+  // They are for the code where exceptions are expected, such as calling user callbacks or probing objects.
+  // Other failures are still thrown as jsi::JSINativeException.
+  virtual JsiResult tryCall(
+      const facebook::jsi::Function &func,
+      const facebook::jsi::Value &jsThis,
+      const facebook::jsi::Value *args,
+      size_t count) = 0;
+  virtual JsiResult tryGetProperty(const facebook::jsi::Object &obj, const facebook::jsi::PropNameID &name) = 0;
+  // Evaluates the script like evaluateJavaScript. The syntax errors are also returned in the JsiResult.
+  virtual JsiResult
+  tryEvaluate(const std::shared_ptr<const facebook::jsi::Buffer> &buffer, const std::string &sourceURL) = 0;
+
+  // Creates a BigInt from the sign and the magnitude stored as little-endian 64-bit words.
+  virtual facebook::jsi::BigInt createBigIntFromWords(bool isNegative, const uint64_t *words, size_t wordCount) = 0;
+  // Copies the BigInt magnitude little-endian 64-bit words without the leading zero words if they fit.
+  // Returns the magnitude word count. The words are not changed if the count is greater than the wordCapacity.
+  // The isNegative receives the BigInt sign if it is not nullptr.
+  virtual size_t
+  getBigIntWords(const facebook::jsi::BigInt &bigint, bool *isNegative, uint64_t *words, size_t wordCapacity) = 0;
+
+  // Calls the callback with the string UTF-8 view. The callback accepts std::string_view.
+  template <typename TString, typename TCallback>
+  void withUtf8(const TString &str, TCallback &&callback) {
+    getUtf8(str, &callback, [](void *context, std::string_view utf8) {
+      (*static_cast<std::remove_reference_t<TCallback> *>(context))(utf8);
+    });
+  }
+};
+
 std::unique_ptr<facebook::jsi::Runtime>
 makeNodeApiJsiRuntime(napi_env env, NodeApi *nodeApi, std::function<void()> onDelete) noexcept;
 
+// Returns the Node-API extensions for a runtime created by makeNodeApiJsiRuntime or nullptr otherwise.
+INodeApiJsiRuntime *getNodeApiJsiRuntime(facebook::jsi::Runtime &runtime) noexcept;
+
 } // namespace Microsoft::NodeApiJsi
 
 #endif // !SRC_NODEAPIJSIRUNTIME_H_
@@ -0,0 +1,162 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+#ifndef SRC_NODEAPIJSISTRUCT_H_
+#define SRC_NODEAPIJSISTRUCT_H_
+
+#include <jsi/jsi.h>
+#include <array>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "NodeApiJsiRuntime.h"
+
+namespace Microsoft::NodeApiJsi {
+
+// Describes a struct field that is converted to a JS object property with the same name.
+template <typename TStruct, typename TField>
+struct JsiStructField {
+  const char *name;
+  TField TStruct::*member;
+};
+
+template <typename TStruct, typename TField>
+constexpr JsiStructField<TStruct, TField> jsiStructField(const char *name, TField TStruct::*member) noexcept {
+  return {name, member};
+}
+
+// Specialize JsiStructFields to enable conversion of a struct to and from JS objects:
+//
+//   template <>
+//   struct JsiStructFields<Point> {
+//     static constexpr auto fields = std::make_tuple(jsiStructField("x", &Point::x), jsiStructField("y", &Point::y));
+//   };
+template <typename TStruct>
+struct JsiStructFields;
+
+// Converts struct field values to and from jsi::Value. Specialize it to support more field types.
+template <typename T, typename Enable = void>
+struct JsiValueConverter;
+
+template <>
+struct JsiValueConverter<bool> {
+  static facebook::jsi::Value toValue(facebook::jsi::Runtime & /*rt*/, bool value) {
+    return facebook::jsi::Value(value);
+  }
+
+  static bool fromValue(facebook::jsi::Runtime & /*rt*/, const facebook::jsi::Value &value) {
+    return value.getBool();
+  }
+};
+
+template <typename T>
+struct JsiValueConverter<T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>>> {
+  static facebook::jsi::Value toValue(facebook::jsi::Runtime & /*rt*/, T value) {
+    return facebook::jsi::Value(static_cast<double>(value));
+  }
+
+  static T fromValue(facebook::jsi::Runtime & /*rt*/, const facebook::jsi::Value &value) {
+    return static_cast<T>(value.getNumber());
+  }
+};
+
+template <>
+struct JsiValueConverter<std::string> {
+  static facebook::jsi::Value toValue(facebook::jsi::Runtime &rt, const std::string &value) {
+    return facebook::jsi::String::createFromUtf8(rt, value);
+  }
+
+  static std::string fromValue(facebook::jsi::Runtime &rt, const facebook::jsi::Value &value) {
+    return value.getString(rt).utf8(rt);
+  }
+};
+
+template <>
+struct JsiValueConverter<facebook::jsi::Value> {
+  static facebook::jsi::Value toValue(facebook::jsi::Runtime &rt, const facebook::jsi::Value &value) {
+    return facebook::jsi::Value(rt, value);
+  }
+
+  static facebook::jsi::Value fromValue(facebook::jsi::Runtime &rt, const facebook::jsi::Value &value) {
+    return facebook::jsi::Value(rt, value);
+  }
+};
+
+// Converts structs described by JsiStructFields to and from JS objects.
+// The property names are created once per runtime. The object properties are set and read in one batch.
+template <typename TStruct>
+class JsiStruct {
+ public:
+  static constexpr size_t FieldCount = std::tuple_size_v<std::decay_t<decltype(JsiStructFields<TStruct>::fields)>>;
+
+  static facebook::jsi::Object toObject(facebook::jsi::Runtime &rt, const TStruct &value) {
+    std::array<facebook::jsi::Value, FieldCount> values = std::apply(
+        [&rt, &value](const auto &...field) {
+          return std::array<facebook::jsi::Value, FieldCount>{toFieldValue(rt, value.*field.member)...};
+        },
+        JsiStructFields<TStruct>::fields);
+    facebook::jsi::Object obj(rt);
+    if (INodeApiJsiRuntime *rtExt = getNodeApiJsiRuntime(rt)) {
+      rtExt->setProperties(obj, rtExt->getCachedPropNameIDs(Names.data(), FieldCount), values.data(), FieldCount);
+    } else {
+      for (size_t i = 0; i < FieldCount; ++i) {
+        obj.setProperty(rt, Names[i], values[i]);
+      }
+    }
+    return obj;
+  }
+
+  static TStruct fromObject(facebook::jsi::Runtime &rt, const facebook::jsi::Object &obj) {
+    std::array<facebook::jsi::Value, FieldCount> values;
+    if (INodeApiJsiRuntime *rtExt = getNodeApiJsiRuntime(rt)) {
+      rtExt->getProperties(obj, rtExt->getCachedPropNameIDs(Names.data(), FieldCount), values.data(), FieldCount);
+    } else {
+      for (size_t i = 0; i < FieldCount; ++i) {
+        values[i] = obj.getProperty(rt, Names[i]);
+      }
+    }
+    TStruct result{};
+    std::apply(
+        [&rt, &result, &values](const auto &...field) {
+          size_t index = 0;
+          (fromFieldValue(rt, values[index++], result.*field.member), ...);
+        },
+        JsiStructFields<TStruct>::fields);
+    return result;
+  }
+
+ private:
+  template <typename TField>
+  static facebook::jsi::Value toFieldValue(facebook::jsi::Runtime &rt, const TField &value) {
+    return JsiValueConverter<TField>::toValue(rt, value);
+  }
+
+  template <typename TField>
+  static void fromFieldValue(facebook::jsi::Runtime &rt, const facebook::jsi::Value &value, TField &field) {
+    field = JsiValueConverter<TField>::fromValue(rt, value);
+  }
+
+ private:
+  // The names array address is the key for the runtime PropNameID cache.
+  static constexpr std::array<const char *, FieldCount> Names = std::apply(
+      [](const auto &...field) { return std::array<const char *, FieldCount>{field.name...}; },
+      JsiStructFields<TStruct>::fields);
+};
+
+// Nested structs are converted with JsiStruct.
+template <typename T>
+struct JsiValueConverter<T, std::void_t<decltype(JsiStructFields<T>::fields)>> {
+  static facebook::jsi::Value toValue(facebook::jsi::Runtime &rt, const T &value) {
+    return JsiStruct<T>::toObject(rt, value);
+  }
+
+  static T fromValue(facebook::jsi::Runtime &rt, const facebook::jsi::Value &value) {
+    return JsiStruct<T>::fromObject(rt, value.getObject(rt));
+  }
+};
+
+} // namespace Microsoft::NodeApiJsi
+
+#endif // !SRC_NODEAPIJSISTRUCT_H_
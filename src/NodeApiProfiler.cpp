@@ -0,0 +1,227 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "NodeApiProfiler.h"
+#include <jsi/jsi.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+
+using namespace facebook;
+
+namespace Microsoft::NodeApiJsi {
+
+namespace {
+
+// The N-API calls made outside of any JSI method such as the calls made directly by the runtime host.
+constexpr std::string_view NoJsiMethod = "(none)";
+
+#ifndef NODE_API_JSI_STATIC_LINK
+
+// Indexes of the NodeApi functions in the order of the NodeApi::funcNames.
+enum class FuncIndex : size_t {
+#define NODE_API_FUNC(func) func,
+#define NODE_API_EXT_FUNC NODE_API_FUNC
+#define NODE_API_PREPARED_SCRIPT NODE_API_FUNC
+#include "NodeApiFunctions.inc"
+  Count
+};
+
+#endif // !NODE_API_JSI_STATIC_LINK
+
+} // namespace
+
+std::atomic<NodeApiProfiler *> NodeApiProfiler::active_{};
+thread_local const char *NodeApiProfiler::currentJsiMethod_{};
+
+#ifdef NODE_API_JSI_STATIC_LINK
+
+NodeApiProfiler::NodeApiProfiler(NodeApi *nodeApi) : nodeApi_(nodeApi) {
+  throw jsi::JSINativeException("NodeApiProfiler is not supported for the statically linked Node-API.");
+}
+
+NodeApiProfiler::~NodeApiProfiler() = default;
+
+void NodeApiProfiler::recordFuncCall(size_t /*funcIndex*/, uint64_t /*nanoseconds*/) noexcept {}
+
+#else
+
+// The trampoline that replaces a NodeApi function table entry while the profiler is active.
+template <typename TResult, typename... TArgs, size_t funcIndex>
+struct NodeApiProfiler::Trampoline<TResult(NAPI_CDECL *)(TArgs...), funcIndex> {
+  static TResult NAPI_CDECL call(TArgs... args) {
+    using TFunc = TResult(NAPI_CDECL *)(TArgs...);
+    NodeApiProfiler *profiler = active();
+    TFunc func = reinterpret_cast<TFunc>(profiler->originalFuncs_[funcIndex]);
+    auto startTime = std::chrono::steady_clock::now();
+    TResult result = (*func)(args...);
+    auto duration = std::chrono::steady_clock::now() - startTime;
+    profiler->recordFuncCall(
+        funcIndex, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+    return result;
+  }
+};
+
+NodeApiProfiler::NodeApiProfiler(NodeApi *nodeApi)
+    : nodeApi_(nodeApi),
+      originalFuncs_(static_cast<size_t>(FuncIndex::Count)),
+      funcCounters_(static_cast<size_t>(FuncIndex::Count)) {
+  if (nodeApi->bindingMode() != ApiBindingMode::Eager) {
+    throw jsi::JSINativeException("NodeApiProfiler requires the NodeApi with the eager binding.");
+  }
+  NodeApiProfiler *expected{};
+  if (!active_.compare_exchange_strong(expected, this)) {
+    throw jsi::JSINativeException("Another NodeApiProfiler is already active.");
+  }
+
+#define NODE_API_FUNC(func)                                                                                   \
+  originalFuncs_[static_cast<size_t>(FuncIndex::func)] = reinterpret_cast<FuncPtr>(nodeApi_->func);          \
+  const_cast<decltype(::func) *&>(nodeApi_->func) =                                                           \
+      &Trampoline<decltype(::func) *, static_cast<size_t>(FuncIndex::func)>::call;
+#define NODE_API_EXT_FUNC NODE_API_FUNC
+#define NODE_API_PREPARED_SCRIPT NODE_API_FUNC
+#include "NodeApiFunctions.inc"
+}
+
+NodeApiProfiler::~NodeApiProfiler() {
+#define NODE_API_FUNC(func) \
+  const_cast<decltype(::func) *&>(nodeApi_->func) =   \
+      reinterpret_cast<decltype(::func) *>(originalFuncs_[static_cast<size_t>(FuncIndex::func)]);
+#define NODE_API_EXT_FUNC NODE_API_FUNC
+#define NODE_API_PREPARED_SCRIPT NODE_API_FUNC
+#include "NodeApiFunctions.inc"
+  active_.store(nullptr);
+}
+
+void NodeApiProfiler::recordFuncCall(size_t funcIndex, uint64_t nanoseconds) noexcept {
+  std::string_view jsiMethod = currentJsiMethod_ != nullptr ? currentJsiMethod_ : NoJsiMethod;
+  std::lock_guard<std::mutex> lock{mutex_};
+  FuncCounters &funcCounters = funcCounters_[funcIndex];
+  ++funcCounters.callCount;
+  funcCounters.totalNanoseconds += nanoseconds;
+  funcCounters.maxNanoseconds = std::max(funcCounters.maxNanoseconds, nanoseconds);
+  Counters &funcJsiMethodCounters = funcCounters.jsiMethods[jsiMethod];
+  ++funcJsiMethodCounters.callCount;
+  funcJsiMethodCounters.totalNanoseconds += nanoseconds;
+  Counters &jsiMethodNapiCalls = jsiMethodCounters_[jsiMethod].napiCalls;
+  ++jsiMethodNapiCalls.callCount;
+  jsiMethodNapiCalls.totalNanoseconds += nanoseconds;
+}
+
+#endif // NODE_API_JSI_STATIC_LINK
+
+void NodeApiProfiler::recordJsiMethodCall(std::string_view jsiMethod) noexcept {
+  std::lock_guard<std::mutex> lock{mutex_};
+  ++jsiMethodCounters_[jsiMethod].callCount;
+}
+
+std::vector<NodeApiFuncStats> NodeApiProfiler::getFuncStats() const {
+  const std::vector<const char *> &funcNames = NodeApi::funcNames();
+  std::vector<NodeApiFuncStats> result;
+  std::lock_guard<std::mutex> lock{mutex_};
+  for (size_t i = 0; i < funcCounters_.size(); ++i) {
+    const FuncCounters &funcCounters = funcCounters_[i];
+    if (funcCounters.callCount == 0) {
+      continue;
+    }
+    NodeApiFuncStats &stats = result.emplace_back(NodeApiFuncStats{
+        funcNames[i], funcCounters.callCount, funcCounters.totalNanoseconds, funcCounters.maxNanoseconds, {}});
+    for (const auto &[jsiMethod, counters] : funcCounters.jsiMethods) {
+      stats.jsiMethods.push_back(
+          NodeApiFuncJsiMethodStats{std::string(jsiMethod), counters.callCount, counters.totalNanoseconds});
+    }
+    std::sort(stats.jsiMethods.begin(), stats.jsiMethods.end(), [](const auto &left, const auto &right) {
+      return left.totalNanoseconds > right.totalNanoseconds;
+    });
+  }
+  std::sort(result.begin(), result.end(), [](const NodeApiFuncStats &left, const NodeApiFuncStats &right) {
+    return left.totalNanoseconds > right.totalNanoseconds;
+  });
+  return result;
+}
+
+std::vector<NodeApiJsiMethodStats> NodeApiProfiler::getJsiMethodStats() const {
+  std::vector<NodeApiJsiMethodStats> result;
+  std::lock_guard<std::mutex> lock{mutex_};
+  result.reserve(jsiMethodCounters_.size());
+  for (const auto &[jsiMethod, counters] : jsiMethodCounters_) {
+    result.push_back(NodeApiJsiMethodStats{
+        std::string(jsiMethod), counters.callCount, counters.napiCalls.callCount, counters.napiCalls.totalNanoseconds});
+  }
+  std::sort(result.begin(), result.end(), [](const NodeApiJsiMethodStats &left, const NodeApiJsiMethodStats &right) {
+    return left.napiCallCount > right.napiCallCount;
+  });
+  return result;
+}
+
+std::string NodeApiProfiler::getReport() const {
+  std::ostringstream report;
+  char line[256];
+  std::snprintf(
+      line, sizeof(line), "%-48s %12s %14s %10s %10s  %s\n", "N-API function", "calls", "total us", "avg ns",
+      "max ns", "top JSI method");
+  report << line;
+  for (const NodeApiFuncStats &stats : getFuncStats()) {
+    std::snprintf(
+        line, sizeof(line), "%-48s %12llu %14.1f %10llu %10llu  %s\n", stats.funcName,
+        static_cast<unsigned long long>(stats.callCount), stats.totalNanoseconds / 1000.0,
+        static_cast<unsigned long long>(stats.totalNanoseconds / stats.callCount),
+        static_cast<unsigned long long>(stats.maxNanoseconds), stats.jsiMethods.front().jsiMethod.c_str());
+    report << line;
+  }
+
+  std::snprintf(
+      line, sizeof(line), "\n%-48s %12s %14s %10s %14s\n", "JSI method", "calls", "N-API calls", "per call",
+      "N-API us");
+  report << line;
+  for (const NodeApiJsiMethodStats &stats : getJsiMethodStats()) {
+    std::snprintf(
+        line, sizeof(line), "%-48s %12llu %14llu %10.1f %14.1f\n", stats.jsiMethod.c_str(),
+        static_cast<unsigned long long>(stats.callCount), static_cast<unsigned long long>(stats.napiCallCount),
+        stats.callCount != 0 ? static_cast<double>(stats.napiCallCount) / stats.callCount : 0.0,
+        stats.napiTotalNanoseconds / 1000.0);
+    report << line;
+  }
+  return report.str();
+}
+
+// The function and JSI method names are C++ identifiers that do not need JSON escaping.
+std::string NodeApiProfiler::getJsonReport() const {
+  std::ostringstream json;
+  json << R"({"type":"NodeApiProfiler","version":1,"functions":[)";
+  bool isFirst = true;
+  for (const NodeApiFuncStats &stats : getFuncStats()) {
+    json << (isFirst ? "" : ",") << R"({"name":")" << stats.funcName << R"(","callCount":)" << stats.callCount
+         << R"(,"totalNanoseconds":)" << stats.totalNanoseconds << R"(,"maxNanoseconds":)" << stats.maxNanoseconds
+         << R"(,"jsiMethods":[)";
+    bool isFirstMethod = true;
+    for (const NodeApiFuncJsiMethodStats &methodStats : stats.jsiMethods) {
+      json << (isFirstMethod ? "" : ",") << R"({"name":")" << methodStats.jsiMethod << R"(","callCount":)"
+           << methodStats.callCount << R"(,"totalNanoseconds":)" << methodStats.totalNanoseconds << "}";
+      isFirstMethod = false;
+    }
+    json << "]}";
+    isFirst = false;
+  }
+  json << R"(],"jsiMethods":[)";
+  isFirst = true;
+  for (const NodeApiJsiMethodStats &stats : getJsiMethodStats()) {
+    json << (isFirst ? "" : ",") << R"({"name":")" << stats.jsiMethod << R"(","callCount":)" << stats.callCount
+         << R"(,"napiCallCount":)" << stats.napiCallCount << R"(,"napiTotalNanoseconds":)"
+         << stats.napiTotalNanoseconds << "}";
+    isFirst = false;
+  }
+  json << "]}";
+  return json.str();
+}
+
+void NodeApiProfiler::reset() {
+  std::lock_guard<std::mutex> lock{mutex_};
+  for (FuncCounters &funcCounters : funcCounters_) {
+    funcCounters = FuncCounters{};
+  }
+  jsiMethodCounters_.clear();
+}
+
+} // namespace Microsoft::NodeApiJsi
@@ -0,0 +1,145 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+#ifndef SRC_NODEAPIPROFILER_H_
+#define SRC_NODEAPIPROFILER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "NodeApi.h"
+
+namespace Microsoft::NodeApiJsi {
+
+// Calls of one N-API function made while running one JSI method.
+struct NodeApiFuncJsiMethodStats {
+  std::string jsiMethod;
+  uint64_t callCount;
+  uint64_t totalNanoseconds;
+};
+
+// Calls of one N-API function.
+struct NodeApiFuncStats {
+  const char *funcName;
+  uint64_t callCount;
+  uint64_t totalNanoseconds;
+  uint64_t maxNanoseconds;
+  // The JSI methods that made the calls sorted by the total time in descending order.
+  std::vector<NodeApiFuncJsiMethodStats> jsiMethods;
+};
+
+// Calls of one JSI method and the N-API calls that it made directly.
+// A JSI method that is called by another JSI method takes over the attribution of the N-API calls until it returns.
+struct NodeApiJsiMethodStats {
+  std::string jsiMethod;
+  uint64_t callCount;
+  uint64_t napiCallCount;
+  uint64_t napiTotalNanoseconds;
+};
+
+// Profiles the N-API calls made through a NodeApi function table.
+// The constructor replaces each table entry with a trampoline that counts and times the calls to the original
+// function, and the destructor restores the original functions. The NodeApiJsiRuntime attributes the calls to the
+// JSI methods and host callbacks that make them.
+// Only one profiler can be active in the process because the trampolines are shared by all instances.
+// It requires the eager binding because the lazy binding stubs replace the table entries on their first call.
+// It is not supported in the NODE_API_JSI_STATIC_LINK mode that has no function pointers to replace.
+// The profiler must be destroyed when no N-API calls run through the profiled table.
+class NodeApiProfiler {
+ public:
+  // Throws jsi::JSINativeException if the profiling is not supported for the nodeApi or another profiler is active.
+  explicit NodeApiProfiler(NodeApi *nodeApi);
+  ~NodeApiProfiler();
+
+  NodeApiProfiler(const NodeApiProfiler &) = delete;
+  NodeApiProfiler &operator=(const NodeApiProfiler &) = delete;
+
+  static NodeApiProfiler *active() noexcept {
+    return active_.load(std::memory_order_relaxed);
+  }
+
+  // Returns stats of the called functions sorted by the total time in descending order.
+  std::vector<NodeApiFuncStats> getFuncStats() const;
+
+  // Returns stats of the called JSI methods sorted by the N-API call count in descending order.
+  std::vector<NodeApiJsiMethodStats> getJsiMethodStats() const;
+
+  // Returns a text table of the called functions and JSI methods sorted the same way as the stats.
+  std::string getReport() const;
+
+  // Returns the stats as a JSON object with the "type" and "version" fields. It is the report for the tools that
+  // collect the profiles from the NodeApiProfiler::active() instance.
+  std::string getJsonReport() const;
+
+  void reset();
+
+  // Attributes the N-API calls made on the current thread to the JSI method while the scope is alive.
+  // It does nothing if there is no active profiler.
+  class JsiMethodScope {
+   public:
+    explicit JsiMethodScope(const char *jsiMethod) noexcept {
+      if (NodeApiProfiler *profiler = active()) {
+        profiler_ = profiler;
+        prevJsiMethod_ = currentJsiMethod_;
+        currentJsiMethod_ = jsiMethod;
+        profiler->recordJsiMethodCall(jsiMethod);
+      }
+    }
+
+    ~JsiMethodScope() {
+      if (profiler_ != nullptr) {
+        currentJsiMethod_ = prevJsiMethod_;
+      }
+    }
+
+    JsiMethodScope(const JsiMethodScope &) = delete;
+    JsiMethodScope &operator=(const JsiMethodScope &) = delete;
+
+   private:
+    NodeApiProfiler *profiler_{};
+    const char *prevJsiMethod_{};
+  };
+
+ private:
+  template <typename TFunc, size_t funcIndex>
+  struct Trampoline;
+
+  struct Counters {
+    uint64_t callCount;
+    uint64_t totalNanoseconds;
+  };
+
+  struct FuncCounters {
+    uint64_t callCount;
+    uint64_t totalNanoseconds;
+    uint64_t maxNanoseconds;
+    std::unordered_map<std::string_view, Counters> jsiMethods;
+  };
+
+  struct JsiMethodCounters {
+    uint64_t callCount;
+    Counters napiCalls;
+  };
+
+  void recordFuncCall(size_t funcIndex, uint64_t nanoseconds) noexcept;
+  void recordJsiMethodCall(std::string_view jsiMethod) noexcept;
+
+ private:
+  NodeApi *nodeApi_;
+  std::vector<FuncPtr> originalFuncs_;
+  mutable std::mutex mutex_;
+  std::vector<FuncCounters> funcCounters_;
+  std::unordered_map<std::string_view, JsiMethodCounters> jsiMethodCounters_;
+
+  static std::atomic<NodeApiProfiler *> active_;
+  static thread_local const char *currentJsiMethod_;
+};
+
+} // namespace Microsoft::NodeApiJsi
+
+#endif // !SRC_NODEAPIPROFILER_H_
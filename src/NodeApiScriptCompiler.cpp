@@ -0,0 +1,116 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "NodeApiScriptCompiler.h"
+#include <utility>
+
+namespace Microsoft::NodeApiJsi {
+
+//=====================================================================================================================
+// NodeApiScriptCompiler::CompiledScript implementation
+//=====================================================================================================================
+
+NodeApiScriptCompiler::CompiledScript::CompiledScript(
+    std::shared_ptr<State> state,
+    napi_status status,
+    napi_ext_compiled_script script) noexcept
+    : state_(std::move(state)), status_(status), script_(script) {
+  if (script_ != nullptr) {
+    std::scoped_lock lock{state_->mutex};
+    state_->compiledScripts.insert(this);
+  }
+}
+
+NodeApiScriptCompiler::CompiledScript::~CompiledScript() {
+  std::scoped_lock lock{state_->mutex};
+  if (script_ != nullptr) {
+    state_->compiledScripts.erase(this);
+    NodeApi::Scope apiScope{state_->nodeApi};
+    state_->nodeApi->napi_ext_delete_compiled_script(script_);
+  }
+}
+
+napi_ext_compiled_script NodeApiScriptCompiler::CompiledScript::release() noexcept {
+  std::scoped_lock lock{state_->mutex};
+  state_->compiledScripts.erase(this);
+  return std::exchange(script_, nullptr);
+}
+
+//=====================================================================================================================
+// NodeApiScriptCompiler implementation
+//=====================================================================================================================
+
+NodeApiScriptCompiler::NodeApiScriptCompiler(NodeApi *nodeApi) : state_(std::make_shared<State>()) {
+  state_->nodeApi = nodeApi;
+}
+
+NodeApiScriptCompiler::~NodeApiScriptCompiler() {
+  std::deque<Task> skippedTasks;
+  {
+    std::scoped_lock lock{state_->mutex};
+    isStopped_ = true;
+    skippedTasks.swap(tasks_);
+  }
+  taskAdded_.notify_one();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+
+  // The compiled scripts that are not released yet must not use the NodeApi after this point.
+  std::scoped_lock lock{state_->mutex};
+  NodeApi::Scope apiScope{state_->nodeApi};
+  for (CompiledScript *compiledScript : state_->compiledScripts) {
+    state_->nodeApi->napi_ext_delete_compiled_script(std::exchange(compiledScript->script_, nullptr));
+  }
+  state_->compiledScripts.clear();
+  state_->nodeApi = nullptr;
+}
+
+void NodeApiScriptCompiler::compileAsync(
+    std::shared_ptr<const facebook::jsi::Buffer> buffer,
+    std::string sourceURL,
+    Callback callback) {
+  {
+    std::scoped_lock lock{state_->mutex};
+    tasks_.push_back(Task{std::move(buffer), std::move(sourceURL), std::move(callback)});
+    if (!thread_.joinable()) {
+      thread_ = std::thread([this]() { runTasks(); });
+    }
+  }
+  taskAdded_.notify_one();
+}
+
+// Runs the tasks on the compiler thread until the compiler is deleted.
+void NodeApiScriptCompiler::runTasks() {
+  // The nodeApi is only changed after the thread is joined.
+  NodeApi *nodeApi = state_->nodeApi;
+  NodeApi::Scope apiScope{nodeApi};
+  std::unique_lock lock{state_->mutex};
+  for (;;) {
+    taskAdded_.wait(lock, [this]() { return isStopped_ || !tasks_.empty(); });
+    if (isStopped_) {
+      return;
+    }
+    Task task = std::move(tasks_.front());
+    tasks_.pop_front();
+    lock.unlock();
+
+    napi_ext_compiled_script script{};
+    napi_status status =
+        nodeApi->napi_ext_compile_script(task.buffer->data(), task.buffer->size(), task.sourceURL.c_str(), &script);
+    auto compiledScript = std::make_shared<CompiledScript>(state_, status, status == napi_ok ? script : nullptr);
+
+    // The script compiled while the compiler is being deleted is deleted here instead of being passed to the callback.
+    lock.lock();
+    bool isStopped = isStopped_;
+    lock.unlock();
+    if (!isStopped) {
+      task.callback(std::move(compiledScript));
+    }
+    compiledScript.reset();
+    task = Task{};
+    lock.lock();
+  }
+}
+
+} // namespace Microsoft::NodeApiJsi
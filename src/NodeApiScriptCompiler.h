@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+#ifndef SRC_NODEAPISCRIPTCOMPILER_H_
+#define SRC_NODEAPISCRIPTCOMPILER_H_
+
+#include <jsi/jsi.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include "NodeApi.h"
+
+namespace Microsoft::NodeApiJsi {
+
+// Compiles scripts with the napi_ext_compile_script on one background thread.
+// The compiled scripts are passed to the callbacks in the order of the compileAsync calls.
+// The owner deletes the compiler before the NodeApi is deleted. The destructor skips the queued scripts, waits for
+// the running compilation, and deletes the compiled scripts that are not released yet. The compiled scripts can
+// outlive the compiler, and they do not use the NodeApi after it.
+class NodeApiScriptCompiler {
+ private:
+  struct State;
+
+ public:
+  // Owns the napi_ext_compiled_script until it is released. It can be used and deleted on any thread.
+  class CompiledScript {
+   public:
+    CompiledScript(std::shared_ptr<State> state, napi_status status, napi_ext_compiled_script script) noexcept;
+    ~CompiledScript();
+
+    CompiledScript(const CompiledScript &) = delete;
+    CompiledScript &operator=(const CompiledScript &) = delete;
+
+    // The status of the napi_ext_compile_script call.
+    napi_status status() const noexcept {
+      return status_;
+    }
+
+    // Passes the ownership of the compiled script to the caller.
+    // Returns nullptr if the compilation failed or the compiler is deleted.
+    napi_ext_compiled_script release() noexcept;
+
+   private:
+    friend class NodeApiScriptCompiler;
+
+    std::shared_ptr<State> state_;
+    napi_status status_;
+    napi_ext_compiled_script script_;
+  };
+
+  // Receives the compiled script on the compiler thread. It is not called for the skipped scripts.
+  using Callback = std::function<void(std::shared_ptr<CompiledScript> script)>;
+
+  explicit NodeApiScriptCompiler(NodeApi *nodeApi);
+  ~NodeApiScriptCompiler();
+
+  NodeApiScriptCompiler(const NodeApiScriptCompiler &) = delete;
+  NodeApiScriptCompiler &operator=(const NodeApiScriptCompiler &) = delete;
+
+  // Queues the script for the compilation. The thread is started by the first call.
+  void compileAsync(std::shared_ptr<const facebook::jsi::Buffer> buffer, std::string sourceURL, Callback callback);
+
+ private:
+  struct Task {
+    std::shared_ptr<const facebook::jsi::Buffer> buffer;
+    std::string sourceURL;
+    Callback callback;
+  };
+
+  // The state is shared with the compiled scripts. The mutex guards its fields and the compiler tasks.
+  struct State {
+    std::mutex mutex;
+    // It is nullptr after the compiler is deleted.
+    NodeApi *nodeApi;
+    std::unordered_set<CompiledScript *> compiledScripts;
+  };
+
+  void runTasks();
+
+ private:
+  std::shared_ptr<State> state_;
+  std::condition_variable taskAdded_;
+  std::deque<Task> tasks_;
+  bool isStopped_{};
+  std::thread thread_;
+};
+
+} // namespace Microsoft::NodeApiJsi
+
+#endif // !SRC_NODEAPISCRIPTCOMPILER_H_
@@ -1,16 +1,86 @@
 // Copyright (c) Microsoft Corporation.
 // Licensed under the MIT License.
 
-#include "LibLoader.h"
+#include "NodeApi.h"
+#include <dlfcn.h>
+#include <unistd.h>
+#include <cstring>
+#include <string>
+#include <string_view>
 
 namespace Microsoft::NodeApiJsi {
 
-LibHandle LibLoader::loadLib(const char *libName) {
-  // TODO: implement
+namespace {
+
+#ifdef __APPLE__
+constexpr const char *LibExtension = ".dylib";
+#else
+constexpr const char *LibExtension = ".so";
+#endif
+
+// Maps the base library name to the platform file name. The names with a path or extension are used as is.
+std::string getLibFileName(const char *libName) {
+  if (std::strchr(libName, '/') != nullptr || std::strchr(libName, '.') != nullptr) {
+    return libName;
+  }
+  return std::string("lib") + libName + LibExtension;
+}
+
+// Gets the directory of the running executable with the trailing slash or an empty string if it is unknown.
+std::string getExecutableDir() {
+#ifdef __linux__
+  char path[4096];
+  ssize_t length = ::readlink("/proc/self/exe", path, sizeof(path) - 1);
+  if (length > 0) {
+    std::string_view exePath(path, static_cast<size_t>(length));
+    size_t slashPos = exePath.rfind('/');
+    if (slashPos != std::string_view::npos) {
+      return std::string(exePath.substr(0, slashPos + 1));
+    }
+  }
+#endif
+  return {};
+}
+
+} // namespace
+
+LibHandle LibLoader::loadLib(const char *libName, const LibLoadOptions &options) {
+  int flags = (options.bindNow ? RTLD_NOW : RTLD_LAZY) | RTLD_LOCAL;
+  std::string fileName = getLibFileName(libName);
+  bool hasPath = fileName.find('/') != std::string::npos;
+  if (!hasPath) {
+    for (const std::string &searchPath : options.searchPaths) {
+      std::string filePath = searchPath;
+      if (!filePath.empty() && filePath.back() != '/') {
+        filePath += '/';
+      }
+      filePath += fileName;
+      if (void *handle = ::dlopen(filePath.c_str(), flags)) {
+        return reinterpret_cast<LibHandle>(handle);
+      }
+    }
+  }
+
+  if (void *handle = ::dlopen(fileName.c_str(), flags)) {
+    return reinterpret_cast<LibHandle>(handle);
+  }
+
+  // Unlike Windows, the default search does not include the executable directory. Try it last.
+  if (!hasPath) {
+    std::string exeDir = getExecutableDir();
+    if (!exeDir.empty()) {
+      return reinterpret_cast<LibHandle>(::dlopen((exeDir + fileName).c_str(), flags));
+    }
+  }
+  return nullptr;
 }
 
 FuncPtr LibLoader::getFuncPtr(LibHandle libHandle, const char *funcName) {
-  // TODO: implement
+  // The null handle means RTLD_DEFAULT for the dlsym. Do not search the global symbols instead of the library.
+  if (libHandle == nullptr) {
+    return nullptr;
+  }
+  return reinterpret_cast<FuncPtr>(::dlsym(reinterpret_cast<void *>(libHandle), funcName));
 }
 
 } // namespace Microsoft::NodeApiJsi
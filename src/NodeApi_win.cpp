@@ -5,10 +5,36 @@
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #include <windows.h>
+#include <string>
 
 namespace Microsoft::NodeApiJsi {
 
-LibHandle LibLoader::loadLib(const char *libName) {
+LibHandle LibLoader::loadLib(const char *libName, const LibLoadOptions &options) {
+  // Windows binds all imports when the library is loaded. The bindNow option is ignored.
+  for (const std::string &searchPath : options.searchPaths) {
+    std::string filePath = searchPath;
+    if (!filePath.empty() && filePath.back() != '\\' && filePath.back() != '/') {
+      filePath += '\\';
+    }
+    filePath += libName;
+    // The LOAD_LIBRARY_SEARCH_DLL_LOAD_DIR requires an absolute path. Relative search paths are resolved
+    // against the current directory.
+    DWORD fullPathSize = GetFullPathNameA(filePath.c_str(), 0, nullptr, nullptr);
+    if (fullPathSize == 0) {
+      continue;
+    }
+    std::string fullPath(fullPathSize, '\0');
+    fullPathSize = GetFullPathNameA(filePath.c_str(), fullPathSize, fullPath.data(), nullptr);
+    if (fullPathSize == 0 || fullPathSize >= fullPath.size()) {
+      continue;
+    }
+    fullPath.resize(fullPathSize);
+    // The library dependencies are searched in its directory and then in the default directories.
+    if (HMODULE module = LoadLibraryExA(
+            fullPath.c_str(), nullptr, LOAD_LIBRARY_SEARCH_DLL_LOAD_DIR | LOAD_LIBRARY_SEARCH_DEFAULT_DIRS)) {
+      return reinterpret_cast<LibHandle>(module);
+    }
+  }
   return reinterpret_cast<LibHandle>(LoadLibraryA(libName));
 }
 
@@ -0,0 +1,140 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <FileScriptCache.h>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <vector>
+
+using namespace Microsoft::NodeApiJsi;
+namespace fs = std::filesystem;
+
+class FileScriptCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    directory_ = fs::temp_directory_path() / ("FileScriptCacheTest-" + std::to_string(std::random_device{}()));
+  }
+
+  void TearDown() override {
+    std::error_code ec;
+    fs::remove_all(directory_, ec);
+  }
+
+  static std::vector<uint8_t> makeData(size_t size, uint8_t seed) {
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i) {
+      data[i] = static_cast<uint8_t>(i * 31 + seed);
+    }
+    return data;
+  }
+
+  static bool hasData(const std::shared_ptr<const facebook::jsi::Buffer> &buffer, const std::vector<uint8_t> &data) {
+    return buffer && buffer->size() == data.size() && std::memcmp(buffer->data(), data.data(), data.size()) == 0;
+  }
+
+  std::vector<fs::path> getFiles() const {
+    std::vector<fs::path> files;
+    for (const fs::directory_entry &entry : fs::directory_iterator(directory_)) {
+      files.push_back(entry.path());
+    }
+    return files;
+  }
+
+  fs::path directory_;
+};
+
+TEST_F(FileScriptCacheTest, StoreAndLoad) {
+  FileScriptCache cache(directory_, 1024 * 1024);
+  ScriptCacheKey key{"app.js", 123, "Hermes", 96, "bytecode"};
+  std::vector<uint8_t> data = makeData(1000, 1);
+  EXPECT_EQ(cache.load(key), nullptr);
+  EXPECT_TRUE(cache.store(key, data.data(), data.size()));
+
+  std::shared_ptr<const facebook::jsi::Buffer> buffer = cache.load(key);
+  ASSERT_TRUE(hasData(buffer, data));
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer->data()) % 16, 0u);
+
+  // Any key field change is a different script.
+  EXPECT_EQ(cache.load(ScriptCacheKey{"app.js", 124, "Hermes", 96, "bytecode"}), nullptr);
+  EXPECT_EQ(cache.load(ScriptCacheKey{"app.js", 123, "Hermes", 97, "bytecode"}), nullptr);
+  EXPECT_EQ(cache.load(ScriptCacheKey{"app2.js", 123, "Hermes", 96, "bytecode"}), nullptr);
+
+  // The new data replaces the old one.
+  std::vector<uint8_t> newData = makeData(500, 2);
+  EXPECT_TRUE(cache.store(key, newData.data(), newData.size()));
+  EXPECT_TRUE(hasData(cache.load(key), newData));
+  EXPECT_TRUE(hasData(buffer, data));
+
+  // Temporary files are not left behind.
+  buffer.reset();
+  EXPECT_EQ(getFiles().size(), 1u);
+
+  FileScriptCacheStats stats = cache.getStats();
+  EXPECT_EQ(stats.hitCount, 2u);
+  EXPECT_EQ(stats.missCount, 4u);
+  EXPECT_EQ(stats.storeCount, 2u);
+}
+
+TEST_F(FileScriptCacheTest, CorruptedFileIsRemoved) {
+  FileScriptCache cache(directory_, 1024 * 1024);
+  ScriptCacheKey key{"app.js", 123, "Hermes", 96, "bytecode"};
+  std::vector<uint8_t> data = makeData(1000, 1);
+  EXPECT_TRUE(cache.store(key, data.data(), data.size()));
+  std::vector<fs::path> files = getFiles();
+  ASSERT_EQ(files.size(), 1u);
+  {
+    std::fstream file(files[0], std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(-10, std::ios::end);
+    file.put('\x7f');
+  }
+
+  EXPECT_EQ(cache.load(key), nullptr);
+  EXPECT_EQ(cache.getStats().corruptionCount, 1u);
+  EXPECT_TRUE(getFiles().empty());
+
+  // Truncated files are also detected.
+  EXPECT_TRUE(cache.store(key, data.data(), data.size()));
+  fs::resize_file(getFiles()[0], 20);
+  EXPECT_EQ(cache.load(key), nullptr);
+  EXPECT_EQ(cache.getStats().corruptionCount, 2u);
+}
+
+TEST_F(FileScriptCacheTest, EvictsLeastRecentlyUsed) {
+  FileScriptCache cache(directory_, 3000);
+  ScriptCacheKey keys[] = {{"a.js", 1, "Hermes", 96, ""}, {"b.js", 2, "Hermes", 96, ""}, {"c.js", 3, "Hermes", 96, ""}};
+  std::vector<uint8_t> data = makeData(1000, 1);
+  EXPECT_TRUE(cache.store(keys[0], data.data(), data.size()));
+  EXPECT_TRUE(cache.store(keys[1], data.data(), data.size()));
+
+  // Make both files old and then use the first one.
+  fs::file_time_type oldTime = fs::file_time_type::clock::now() - std::chrono::hours(1);
+  for (const fs::path &file : getFiles()) {
+    fs::last_write_time(file, oldTime);
+  }
+  EXPECT_NE(cache.load(keys[0]), nullptr);
+
+  EXPECT_TRUE(cache.store(keys[2], data.data(), data.size()));
+  EXPECT_NE(cache.load(keys[0]), nullptr);
+  EXPECT_EQ(cache.load(keys[1]), nullptr);
+  EXPECT_NE(cache.load(keys[2]), nullptr);
+  EXPECT_EQ(cache.getStats().evictionCount, 1u);
+
+  // The data larger than the cache is not stored.
+  std::vector<uint8_t> largeData = makeData(4000, 1);
+  EXPECT_FALSE(cache.store(keys[1], largeData.data(), largeData.size()));
+
+  cache.clear();
+  EXPECT_TRUE(getFiles().empty());
+}
+
+TEST(FileScriptCacheHashTest, MatchesXXH64) {
+  auto hash = [](const char *text) {
+    return FileScriptCache::hash(reinterpret_cast<const uint8_t *>(text), std::strlen(text));
+  };
+  EXPECT_EQ(hash(""), 0xef46db3751d8e999ull);
+  EXPECT_EQ(hash("abc"), 0x44bc2cf5ad770999ull);
+  EXPECT_EQ(hash("Nobody inspects the spammish repetition"), 0xfbcea83c8a378bf1ull);
+}
@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <MappedFileBuffer.h>
+#include <gtest/gtest.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+using namespace Microsoft::NodeApiJsi;
+namespace fs = std::filesystem;
+
+class MappedFileBufferTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    path_ = fs::temp_directory_path() / ("MappedFileBufferTest-" + std::to_string(std::random_device{}()));
+  }
+
+  void TearDown() override {
+    std::error_code ec;
+    fs::remove(path_, ec);
+  }
+
+  std::vector<uint8_t> writeFile(size_t size) {
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i) {
+      data[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+    std::ofstream file(path_, std::ios::binary);
+    file.write(reinterpret_cast<const char *>(data.data()), data.size());
+    return data;
+  }
+
+  fs::path path_;
+};
+
+TEST_F(MappedFileBufferTest, MapsFileContent) {
+  std::vector<uint8_t> data = writeFile(3 * 1024 * 1024 + 123);
+  MappedFileOptions allOptions[] = {
+      {false, false, false, false},
+      {true, true, false, false},
+      {true, true, true, false},
+      {true, false, true, true},
+  };
+  for (const MappedFileOptions &options : allOptions) {
+    MappedFileBuffer buffer(path_.string(), options);
+    ASSERT_EQ(buffer.size(), data.size());
+    EXPECT_EQ(std::memcmp(buffer.data(), data.data(), data.size()), 0);
+    EXPECT_GE(buffer.loadStats().loadMicroseconds, 0.0);
+    EXPECT_LE(buffer.loadStats().pageFaults.majorPageFaultCount, buffer.loadStats().pageFaults.pageFaultCount);
+  }
+}
+
+TEST_F(MappedFileBufferTest, MapsEmptyFile) {
+  writeFile(0);
+  MappedFileBuffer buffer(path_.string());
+  EXPECT_EQ(buffer.size(), 0u);
+}
+
+TEST_F(MappedFileBufferTest, ThrowsForMissingFile) {
+  EXPECT_THROW(MappedFileBuffer(path_.string()), facebook::jsi::JSINativeException);
+}
+
+TEST(PageFaultCountsTest, CountsTouchedPages) {
+  PageFaultCounts start = getPageFaultCounts();
+  std::vector<uint8_t> memory(16 * 1024 * 1024, 1);
+  PageFaultCounts end = getPageFaultCounts();
+  EXPECT_GT(end.pageFaultCount, start.pageFaultCount);
+  EXPECT_GE(end.majorPageFaultCount, start.majorPageFaultCount);
+}
@@ -0,0 +1,1020 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+// Benchmarks for the NodeApiJsiRuntime.
+// They report the average time per iteration and only check the correctness of the results.
+// They are built into the jsi_benchmarks executable that is not run by CTest.
+
+#include <FileScriptCache.h>
+#include <HermesApi.h>
+#include <MappedFileBuffer.h>
+#include <NodeApiJsiRuntime.h>
+#include <NodeApiJsiStruct.h>
+#include <NodeApiProfiler.h>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <random>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "../jsi/test/testlib.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace facebook::jsi;
+using namespace Microsoft::NodeApiJsi;
+
+// A struct field with the "fNNN" name generated from its index.
+template <size_t I>
+struct BenchmarkField {
+  static constexpr char name[] = {'f', char('0' + I / 100 % 10), char('0' + I / 10 % 10), char('0' + I % 10), '\0'};
+  double value{static_cast<double>(I)};
+};
+
+template <typename TIndexes>
+struct BenchmarkStruct;
+
+template <size_t... I>
+struct BenchmarkStruct<std::index_sequence<I...>> : BenchmarkField<I>... {};
+
+template <size_t FieldCount>
+using BenchmarkStructOf = BenchmarkStruct<std::make_index_sequence<FieldCount>>;
+
+template <size_t... I>
+struct Microsoft::NodeApiJsi::JsiStructFields<BenchmarkStruct<std::index_sequence<I...>>> {
+  static constexpr auto fields = std::make_tuple(jsiStructField<BenchmarkStruct<std::index_sequence<I...>>, double>(
+      BenchmarkField<I>::name, &BenchmarkField<I>::value)...);
+};
+
+class NodeApiJsiBenchmark : public JSITestBase {
+ public:
+  // Runs the action the given number of times and returns the average time per run in microseconds.
+  template <typename TAction>
+  static double measure(size_t iterations, TAction &&action) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+      action();
+    }
+    std::chrono::duration<double, std::micro> duration = std::chrono::steady_clock::now() - start;
+    return duration.count() / iterations;
+  }
+
+  static void report(const char *name, double microseconds) {
+    std::printf("[ BENCHMARK] %-48s %12.3f us\n", name, microseconds);
+  }
+
+  static void reportCount(const char *name, uint64_t count) {
+    std::printf("[ BENCHMARK] %-48s %12llu\n", name, static_cast<unsigned long long>(count));
+  }
+
+  // Returns a 10 MB bundle of module functions. Its completion value is "function".
+  static std::string makeBundleSource() {
+    std::string source;
+    for (int i = 0; source.size() < 10 * 1024 * 1024; ++i) {
+      std::string index = std::to_string(i);
+      source += "function module" + index + "(exports) { exports.value" + index + " = " + index + " * 2; }\n";
+    }
+    source += "typeof module0";
+    return source;
+  }
+};
+
+TEST_P(NodeApiJsiBenchmark, GlobalBindingsInstall) {
+  constexpr size_t bindingCount = 1000;
+  constexpr size_t runCount = 5;
+  std::vector<std::string> names;
+  names.reserve(bindingCount);
+  for (size_t i = 0; i < bindingCount; ++i) {
+    names.push_back("binding" + std::to_string(i));
+  }
+
+  auto hostFunction = [](Runtime &, const Value &, const Value *, size_t) { return Value(1); };
+  auto createFunction = [&hostFunction](Runtime &rt, const std::string &name) {
+    return Function::createFromHostFunction(rt, PropNameID::forAscii(rt, name), 0, hostFunction);
+  };
+
+  double eagerTime = 0;
+  double lazyTime = 0;
+  for (size_t run = 0; run < runCount; ++run) {
+    std::unique_ptr<Runtime> eagerRuntime = factory();
+    Runtime &eagerRt = *eagerRuntime;
+    eagerTime += measure(1, [&]() {
+      Object global = eagerRt.global();
+      for (const std::string &name : names) {
+        global.setProperty(eagerRt, PropNameID::forAscii(eagerRt, name), createFunction(eagerRt, name));
+      }
+    });
+
+    std::unique_ptr<Runtime> lazyRuntime = factory();
+    Runtime &lazyRt = *lazyRuntime;
+    INodeApiJsiRuntime *lazyRtExt = getNodeApiJsiRuntime(lazyRt);
+    lazyTime += measure(1, [&]() {
+      Object global = lazyRt.global();
+      for (const std::string &name : names) {
+        lazyRtExt->defineLazyProperty(
+            global, PropNameID::forAscii(lazyRt, name), [&createFunction, name](Runtime &rt) -> Value {
+              return createFunction(rt, name);
+            });
+      }
+    });
+    EXPECT_EQ(lazyRt.global().getPropertyAsFunction(lazyRt, "binding42").call(lazyRt).getNumber(), 1);
+  }
+
+  report("Install 1000 global bindings eagerly", eagerTime / runCount);
+  report("Install 1000 global bindings lazily", lazyTime / runCount);
+}
+
+TEST_P(NodeApiJsiBenchmark, PrimitiveValueConversions) {
+  constexpr size_t iterationCount = 100000;
+  Function countPrimitives = function(
+      "function(a, b, c, d, e, f) { return (a === undefined) + (b === null) + c + !d + (e === 7) + (f === 0.5); }");
+  double callTime = measure(iterationCount, [&]() {
+    Value result = countPrimitives.call(rt, Value::undefined(), Value::null(), true, false, 7, 0.5);
+    EXPECT_EQ(result.getNumber(), 6);
+  });
+  report("Call JS function with 6 primitive arguments", callTime);
+
+  Function returnSmallInt = Function::createFromHostFunction(
+      rt, PropNameID::forAscii(rt, "returnSmallInt"), 1, [](Runtime &, const Value &, const Value *args, size_t) {
+        return Value(static_cast<int32_t>(args[0].getNumber()) % 1000);
+      });
+  Function callHostFunction =
+      function("function(f, n) { let sum = 0; for (let i = 0; i < n; ++i) { sum += f(i); } return sum; }");
+  double hostCallTime = measure(1, [&]() {
+    Value result = callHostFunction.call(rt, returnSmallInt, static_cast<int32_t>(iterationCount));
+    EXPECT_EQ(result.getNumber(), (iterationCount / 1000) * (999 * 1000 / 2));
+  });
+  report("Call host function returning small int", hostCallTime / iterationCount);
+}
+
+// Measures the runtime paths that used to look up the thread-local NodeApi on every call.
+TEST_P(NodeApiJsiBenchmark, HostCallbackOverhead) {
+  constexpr size_t iterationCount = 100000;
+  Function sumArgs = Function::createFromHostFunction(
+      rt, PropNameID::forAscii(rt, "sumArgs"), 0, [](Runtime &, const Value &, const Value *args, size_t count) {
+        double sum = 0;
+        for (size_t i = 0; i < count; ++i) {
+          sum += args[i].getNumber();
+        }
+        return Value(sum);
+      });
+  Function callWith3Args =
+      function("function(f, n) { let sum = 0; for (let i = 0; i < n; ++i) { sum += f(i, 1, 2); } return sum; }");
+  double call3Time = measure(1, [&]() {
+    Value result = callWith3Args.call(rt, sumArgs, static_cast<int32_t>(iterationCount));
+    EXPECT_EQ(result.getNumber(), iterationCount * (iterationCount - 1) / 2.0 + iterationCount * 3);
+  });
+  report("Call host function with 3 arguments", call3Time / iterationCount);
+
+  Function callWith10Args = function(
+      "function(f, n) { let sum = 0; for (let i = 0; i < n; ++i) { sum += f(i, 1, 1, 1, 1, 1, 1, 1, 1, 1); } "
+      "return sum; }");
+  double call10Time = measure(1, [&]() {
+    Value result = callWith10Args.call(rt, sumArgs, static_cast<int32_t>(iterationCount));
+    EXPECT_EQ(result.getNumber(), iterationCount * (iterationCount - 1) / 2.0 + iterationCount * 9);
+  });
+  report("Call host function with 10 arguments", call10Time / iterationCount);
+
+  // Each access resolves the object reference outside of the value scope.
+  Object obj = eval("({ value: 42 })").getObject(rt);
+  PropNameID value = PropNameID::forAscii(rt, "value");
+  double accessTime = measure(iterationCount, [&]() { EXPECT_EQ(obj.getProperty(rt, value).getNumber(), 42); });
+  report("Get property of referenced object", accessTime);
+}
+
+TEST_P(NodeApiJsiBenchmark, ArrayElementAccess) {
+  constexpr size_t elementCount = 100000;
+  INodeApiJsiRuntime *rtExt = getNodeApiJsiRuntime(rt);
+  Array arr(rt, elementCount);
+  std::vector<double> values(elementCount);
+  for (size_t i = 0; i < elementCount; ++i) {
+    values[i] = static_cast<double>(i);
+  }
+
+  double setTime = measure(1, [&]() {
+    for (size_t i = 0; i < elementCount; ++i) {
+      arr.setValueAtIndex(rt, i, values[i]);
+    }
+  });
+  report("Set 100000 array elements one by one", setTime);
+
+  double bulkSetTime = measure(1, [&]() { rtExt->setValuesAtIndex(arr, 0, values.data(), elementCount); });
+  report("Set 100000 array elements in bulk", bulkSetTime);
+
+  double sum = 0;
+  double getTime = measure(1, [&]() {
+    for (size_t i = 0; i < elementCount; ++i) {
+      sum += arr.getValueAtIndex(rt, i).getNumber();
+    }
+  });
+  report("Get 100000 array elements one by one", getTime);
+
+  std::vector<double> result(elementCount);
+  double bulkGetTime = measure(1, [&]() { rtExt->getValuesAtIndex(arr, 0, result.data(), elementCount); });
+  report("Get 100000 array elements in bulk", bulkGetTime);
+  EXPECT_EQ(result, values);
+  EXPECT_EQ(sum, (elementCount - 1) * elementCount / 2.0);
+}
+
+TEST_P(NodeApiJsiBenchmark, ObjectPropertyAccess) {
+  constexpr size_t fieldCount = 20;
+  constexpr size_t iterationCount = 10000;
+  INodeApiJsiRuntime *rtExt = getNodeApiJsiRuntime(rt);
+  std::vector<PropNameID> names;
+  std::vector<Value> values;
+  for (size_t i = 0; i < fieldCount; ++i) {
+    names.push_back(PropNameID::forAscii(rt, "field" + std::to_string(i)));
+    values.emplace_back(static_cast<int32_t>(i));
+  }
+
+  double setTime = measure(iterationCount, [&]() {
+    Object obj(rt);
+    for (size_t i = 0; i < fieldCount; ++i) {
+      obj.setProperty(rt, names[i], values[i]);
+    }
+  });
+  report("Set 20 object properties one by one", setTime);
+
+  double batchSetTime = measure(iterationCount, [&]() {
+    Object obj(rt);
+    rtExt->setProperties(obj, names.data(), values.data(), fieldCount);
+  });
+  report("Set 20 object properties in batch", batchSetTime);
+
+  Object obj(rt);
+  rtExt->setProperties(obj, names.data(), values.data(), fieldCount);
+  double sum = 0;
+  double getTime = measure(iterationCount, [&]() {
+    for (size_t i = 0; i < fieldCount; ++i) {
+      sum += obj.getProperty(rt, names[i]).getNumber();
+    }
+  });
+  report("Get 20 object properties one by one", getTime);
+
+  std::vector<Value> result(fieldCount);
+  double batchGetTime = measure(iterationCount, [&]() {
+    rtExt->getProperties(obj, names.data(), result.data(), fieldCount);
+    for (size_t i = 0; i < fieldCount; ++i) {
+      sum += result[i].getNumber();
+    }
+  });
+  report("Get 20 object properties in batch", batchGetTime);
+  EXPECT_EQ(sum, 2 * iterationCount * (fieldCount - 1) * fieldCount / 2.0);
+}
+
+TEST_P(NodeApiJsiBenchmark, StringUtf8Access) {
+  constexpr size_t iterationCount = 100000;
+  INodeApiJsiRuntime *rtExt = getNodeApiJsiRuntime(rt);
+  String str = String::createFromAscii(rt, "someObjectPropertyName");
+  size_t totalLength = 0;
+
+  double utf8Time = measure(iterationCount, [&]() { totalLength += str.utf8(rt).size(); });
+  report("Get short string with utf8()", utf8Time);
+
+  double withUtf8Time = measure(iterationCount, [&]() {
+    rtExt->withUtf8(str, [&](std::string_view utf8) { totalLength += utf8.size(); });
+  });
+  report("Get short string with withUtf8()", withUtf8Time);
+
+  char buffer[64];
+  double copyUtf8Time = measure(iterationCount, [&]() { totalLength += rtExt->copyUtf8(str, buffer, sizeof(buffer)); });
+  report("Get short string with copyUtf8()", copyUtf8Time);
+  EXPECT_EQ(totalLength, 3 * iterationCount * 22);
+}
+
+TEST_P(NodeApiJsiBenchmark, Utf8StringCreation) {
+  std::string jsonText = "{";
+  while (jsonText.size() < 2000) {
+    jsonText += "\"key" + std::to_string(jsonText.size()) + "\":\"some value\",";
+  }
+  jsonText += "\"end\":0}";
+  std::string largeText(1024 * 1024, 'x');
+
+  struct {
+    const char *name;
+    std::string text;
+    size_t iterationCount;
+  } inputs[] = {{"short key", "propertyName", 100000}, {"2KB JSON", jsonText, 10000}, {"1MB payload", largeText, 20}};
+  for (const auto &input : inputs) {
+    // The trailing non-ASCII character forces the UTF-8 path.
+    std::string nonAsciiText = input.text + "\xC3\xA9";
+    double asciiTime = measure(input.iterationCount, [&]() { String::createFromUtf8(rt, input.text); });
+    report(("Create ASCII " + std::string(input.name) + " from UTF-8").c_str(), asciiTime);
+    double utf8Time = measure(input.iterationCount, [&]() { String::createFromUtf8(rt, nonAsciiText); });
+    report(("Create non-ASCII " + std::string(input.name) + " from UTF-8").c_str(), utf8Time);
+  }
+}
+
+TEST_P(NodeApiJsiBenchmark, ExternalStringCreation) {
+  constexpr size_t iterationCount = 20;
+  INodeApiJsiRuntime *rtExt = getNodeApiJsiRuntime(rt);
+  auto buffer = std::make_shared<StringBuffer>(std::string(1024 * 1024, 'x'));
+  double copyTime = measure(iterationCount, [&]() { String::createFromUtf8(rt, buffer->data(), buffer->size()); });
+  report("Create 1MB string by copying", copyTime);
+
+  double externalTime = measure(iterationCount, [&]() { rtExt->createExternalStringFromUtf8(buffer); });
+  report("Create 1MB external string", externalTime);
+}
+
+// Converts UTF-16 text without surrogate pairs to UTF-8 the same way as the callers without UTF-16 APIs do.
+static std::string bmpUtf16ToUtf8(const std::u16string &utf16) {
+  std::string result;
+  result.reserve(utf16.size() * 3);
+  for (char16_t ch : utf16) {
+    if (ch < 0x80) {
+      result += static_cast<char>(ch);
+    } else if (ch < 0x800) {
+      result += static_cast<char>(0xC0 | (ch >> 6));
+      result += static_cast<char>(0x80 | (ch & 0x3F));
+    } else {
+      result += static_cast<char>(0xE0 | (ch >> 12));
+      result += static_cast<char>(0x80 | ((ch >> 6) & 0x3F));
+      result += static_cast<char>(0x80 | (ch & 0x3F));
+    }
+  }
+  return result;
+}
+
+// Converts UTF-8 text without 4-byte sequences to UTF-16.
+static std::u16string bmpUtf8ToUtf16(const std::string &utf8) {
+  std::u16string result;
+  result.reserve(utf8.size());
+  for (size_t i = 0; i < utf8.size();) {
+    uint8_t ch = static_cast<uint8_t>(utf8[i]);
+    if (ch < 0x80) {
+      result += static_cast<char16_t>(ch);
+      i += 1;
+    } else if (ch < 0xE0) {
+      result += static_cast<char16_t>(((ch & 0x1F) << 6) | (utf8[i + 1] & 0x3F));
+      i += 2;
+    } else {
+      result += static_cast<char16_t>(((ch & 0x0F) << 12) | ((utf8[i + 1] & 0x3F) << 6) | (utf8[i + 2] & 0x3F));
+      i += 3;
+    }
+  }
+  return result;
+}
+
+TEST_P(NodeApiJsiBenchmark, Utf16StringRoundTrip) {
+  constexpr size_t iterationCount = 1000;
+  INodeApiJsiRuntime *rtExt = getNodeApiJsiRuntime(rt);
+  std::u16string text;
+  while (text.size() < 10000) {
+    text += u"\u041F\u0440\u0438\u0432\u0435\u0442, \u043C\u0438\u0440! ";
+  }
+
+  double utf8Time = measure(iterationCount, [&]() {
+    String str = String::createFromUtf8(rt, bmpUtf16ToUtf8(text));
+    EXPECT_EQ(bmpUtf8ToUtf16(str.utf8(rt)).size(), text.size());
+  });
+  report("Round trip 10K UTF-16 string through UTF-8", utf8Time);
+
+  double utf16Time = measure(iterationCount, [&]() {
+    String str = rtExt->createStringFromUtf16(text.data(), text.size());
+    EXPECT_EQ(rtExt->utf16(str).size(), text.size());
+  });
+  report("Round trip 10K UTF-16 string directly", utf16Time);
+}
+
+TEST_P(NodeApiJsiBenchmark, RepeatedStringCreation) {
+  constexpr size_t iterationCount = 100000;
+  INodeApiJsiRuntime *rtExt = getNodeApiJsiRuntime(rt);
+  const std::string values[] = {"pending", "active", "completed", "failed", "cancelled"};
+  Function countLength = function("function(s) { return s.length; }");
+  size_t totalLength = 0;
+
+  auto createStrings = [&]() {
+    const std::string &value = values[totalLength % std::size(values)];
+    totalLength += static_cast<size_t>(countLength.call(rt, String::createFromAscii(rt, value)).getNumber());
+  };
+  double uncachedTime = measure(iterationCount, createStrings);
+  report("Create repeated strings without intern cache", uncachedTime);
+
+  rtExt->enableStringInternCache(256, 64);
+  double cachedTime = measure(iterationCount, createStrings);
+  report("Create repeated strings with intern cache", cachedTime);
+  INodeApiJsiRuntime::StringInternCacheStats stats = rtExt->getStringInternCacheStats();
+  EXPECT_EQ(stats.hitCount + stats.missCount, iterationCount);
+  EXPECT_EQ(stats.missCount, std::size(values));
+}
+
+TEST_P(NodeApiJsiBenchmark, RepeatedScriptEvaluation) {
+  constexpr size_t iterationCount = 10000;
+  INodeApiJsiRuntime *rtExt = getNodeApiJsiRuntime(rt);
+  std::string source = "(function(data) { let html = '';";
+  for (int i = 0; i < 50; ++i) {
+    source += " html += '<li>' + data.item" + std::to_string(i) + " + '</li>';";
+  }
+  source += " return html; })";
+  auto sourceBuffer = std::make_shared<StringBuffer>(source);
+
+  auto evaluate = [&]() { rt.evaluateJavaScript(sourceBuffer, "template.js"); };
+  double uncachedTime = measure(iterationCount, evaluate);
+  report("Evaluate repeated script without cache", uncachedTime);
+
+  rtExt->enablePreparedScriptCache(16);
+  double cachedTime = measure(iterationCount, evaluate);
+  report("Evaluate repeated script with prepared script cache", cachedTime);
+  INodeApiJsiRuntime::PreparedScriptCacheStats stats = rtExt->getPreparedScriptCacheStats();
+  EXPECT_EQ(stats.hitCount, iterationCount - 1);
+  EXPECT_EQ(stats.missCount, 1);
+}
+
+// Measures catching JS errors in C++ with and without reading their message.
+TEST_P(NodeApiJsiBenchmark, JSErrorCatch) {
+  constexpr size_t iterationCount = 10000;
+  Function throwError = function("function() { throw new Error('Expected error'); }");
+  double catchTime = measure(iterationCount, [&]() {
+    try {
+      throwError.call(rt);
+    } catch (const JSError &) {
+    }
+  });
+  report("Catch JSError", catchTime);
+
+  double catchWithMessageTime = measure(iterationCount, [&]() {
+    try {
+      throwError.call(rt);
+    } catch (const JSError &error) {
+      EXPECT_EQ(error.getMessage(), "Expected error");
+    }
+  });
+  report("Catch JSError and read message", catchWithMessageTime);
+}
+
+// Compares the call latency of call with try-catch and tryCall for different throw rates.
+TEST_P(NodeApiJsiBenchmark, ThrowRateCallLatency) {
+  constexpr size_t iterationCount = 10000;
+  INodeApiJsiRuntime *rtExt = getNodeApiJsiRuntime(rt);
+  Function maybeThrow = function("function(shouldThrow) { if (shouldThrow) throw new Error('Expected'); return 1; }");
+  for (size_t throwPercent : {0, 1, 10, 50, 100}) {
+    size_t index = 0;
+    // Spreads the throwing calls evenly over the iterations.
+    auto shouldThrow = [&]() { return (++index * throwPercent) % 100 < throwPercent; };
+    size_t errorCount = 0;
+    double callTime = measure(iterationCount, [&]() {
+      try {
+        maybeThrow.call(rt, shouldThrow());
+      } catch (const JSError &) {
+        ++errorCount;
+      }
+    });
+    size_t tryErrorCount = 0;
+    double tryCallTime = measure(iterationCount, [&]() {
+      Value arg(shouldThrow());
+      if (!rtExt->tryCall(maybeThrow, Value::undefined(), &arg, 1)) {
+        ++tryErrorCount;
+      }
+    });
+    EXPECT_EQ(errorCount, tryErrorCount);
+
+    std::string rate = std::to_string(throwPercent) + "% throws";
+    report(("call with try-catch, " + rate).c_str(), callTime);
+    report(("tryCall, " + rate).c_str(), tryCallTime);
+  }
+}
+
+// Measures how long the JS thread is blocked while a 10 MB bundle is prepared.
+// The JS engines without the off-thread compilation prepare the script synchronously, and the async result is
+// reported as the synchronous fallback.
+TEST_P(NodeApiJsiBenchmark, AsyncPrepareJSThreadBlocking) {
+  INodeApiJsiRuntime *rtExt = getNodeApiJsiRuntime(rt);
+  auto sourceBuffer = std::make_shared<StringBuffer>(makeBundleSource());
+
+  double syncTime = measure(1, [&]() { rt.prepareJavaScript(sourceBuffer, "bundle.js"); });
+  report("JS thread blocked by prepareJavaScript", syncTime);
+
+  // The JS thread is only blocked by the call itself and by the dispatched tasks.
+  std::mutex mutex;
+  std::condition_variable taskAdded;
+  std::deque<std::function<void()>> tasks;
+  std::shared_ptr<const PreparedJavaScript> script;
+  bool isCompleted{};
+  double blockedTime = measure(1, [&]() {
+    rtExt->prepareJavaScriptAsync(
+        sourceBuffer,
+        "bundle.js",
+        [&](std::function<void()> task) {
+          std::scoped_lock lock{mutex};
+          tasks.push_back(std::move(task));
+          taskAdded.notify_one();
+        },
+        [&](std::shared_ptr<const PreparedJavaScript> result, std::exception_ptr /*error*/) {
+          script = std::move(result);
+          isCompleted = true;
+        });
+  });
+  // The callback is called before the method returns only by the synchronous fallback.
+  bool isSynchronous = isCompleted;
+  while (!isCompleted) {
+    std::unique_lock lock{mutex};
+    taskAdded.wait(lock, [&]() { return !tasks.empty(); });
+    std::function<void()> task = std::move(tasks.front());
+    tasks.pop_front();
+    lock.unlock();
+    blockedTime += measure(1, task);
+  }
+  report(
+      isSynchronous ? "JS thread blocked by prepareJavaScriptAsync (synchronous fallback)"
+                    : "JS thread blocked by prepareJavaScriptAsync",
+      blockedTime);
+  ASSERT_NE(script, nullptr);
+  EXPECT_EQ(rt.evaluatePreparedJavaScript(script).getString(rt).utf8(rt), "function");
+}
+
+// Compares loading a bundle file by copying it into memory and by mapping it with different options.
+// The page cache is dropped before each cold load on the platforms that allow it.
+// Each run uses its own runtime. The external script string keeps the file mapped until it is collected, and
+// deleting the runtime releases it, so the pages of the previous run can be dropped.
+TEST_P(NodeApiJsiBenchmark, MappedBundleLoading) {
+  std::string source = makeBundleSource();
+  std::filesystem::path path =
+      std::filesystem::temp_directory_path() / ("MappedBundleLoading-" + std::to_string(std::random_device{}()));
+  {
+    std::ofstream file(path, std::ios::binary);
+    file.write(source.data(), source.size());
+  }
+  auto dropPageCache = [&]() {
+#ifndef _WIN32
+    int fd = ::open(path.string().c_str(), O_RDONLY);
+    ::fdatasync(fd);
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+#endif
+  };
+  auto run = [&](const std::string &name, bool isCold, auto loadBuffer) {
+    if (isCold) {
+      dropPageCache();
+    }
+    std::unique_ptr<Runtime> runtime = factory();
+    Runtime &runRt = *runtime;
+    PageFaultCounts startPageFaults = getPageFaultCounts();
+    std::shared_ptr<const Buffer> buffer;
+    double loadTime = measure(1, [&]() { buffer = loadBuffer(); });
+    double evaluateTime = measure(1, [&]() {
+      Value result = runRt.evaluatePreparedJavaScript(runRt.prepareJavaScript(buffer, "bundle.js"));
+      EXPECT_EQ(result.getString(runRt).utf8(runRt), "function");
+    });
+    PageFaultCounts endPageFaults = getPageFaultCounts();
+    report((name + " load").c_str(), loadTime);
+    report((name + " evaluate").c_str(), evaluateTime);
+    reportCount((name + " page faults").c_str(), endPageFaults.pageFaultCount - startPageFaults.pageFaultCount);
+    reportCount(
+        (name + " major page faults").c_str(),
+        endPageFaults.majorPageFaultCount - startPageFaults.majorPageFaultCount);
+  };
+  auto copyFile = [&]() -> std::shared_ptr<const Buffer> {
+    std::ifstream file(path, std::ios::binary);
+    return std::make_shared<StringBuffer>(std::string(std::istreambuf_iterator<char>(file), {}));
+  };
+  auto mapFile = [&](MappedFileOptions options) {
+    return [&path, options]() -> std::shared_ptr<const Buffer> {
+      return std::make_shared<MappedFileBuffer>(path.string(), options);
+    };
+  };
+  for (bool isCold : {true, false}) {
+    std::string cache = isCold ? "cold" : "warm";
+    run("Bundle copy, " + cache, isCold, copyFile);
+    run("Bundle mmap, " + cache, isCold, mapFile({false, false, false, false}));
+    run("Bundle mmap sequential willneed, " + cache, isCold, mapFile({true, true, false, false}));
+    run("Bundle mmap populate, " + cache, isCold, mapFile({true, true, true, false}));
+    run("Bundle mmap populate huge pages, " + cache, isCold, mapFile({true, true, true, true}));
+  }
+
+  std::error_code ec;
+  std::filesystem::remove(path, ec);
+}
+
+TEST_P(NodeApiJsiBenchmark, BigIntToString) {
+  Function makeBigInt = function("function(bits) { return (1n << BigInt(bits)) / 3n; }");
+  struct {
+    int32_t bits;
+    size_t iterationCount;
+  } inputs[] = {{64, 100000}, {1000, 10000}, {10000, 200}, {100000, 5}};
+  for (const auto &input : inputs) {
+    BigInt value = makeBigInt.call(rt, input.bits).getBigInt(rt);
+    for (int32_t radix : {10, 16}) {
+      double time = measure(input.iterationCount, [&]() { value.toString(rt, radix); });
+      std::string name = "BigInt " + std::to_string(input.bits) + "-bit toString(" + std::to_string(radix) + ")";
+      report(name.c_str(), time);
+    }
+  }
+}
+
+TEST_P(NodeApiJsiBenchmark, BigIntWordsTransfer) {
+  INodeApiJsiRuntime *rtExt = getNodeApiJsiRuntime(rt);
+  Function parseHex = function("function(hex) { return BigInt('0x' + hex); }");
+  for (size_t wordCount : {2, 16, 256}) {
+    std::vector<uint64_t> words(wordCount);
+    for (size_t i = 0; i < wordCount; ++i) {
+      words[i] = (i + 1) * 0x9e3779b97f4a7c15ull;
+    }
+    BigInt value = rtExt->createBigIntFromWords(false, words.data(), words.size());
+    std::string hex = value.toString(rt, 16).utf8(rt);
+    std::vector<uint64_t> result(wordCount);
+    bool isNegative{};
+    size_t iterationCount = 100000 / wordCount;
+
+    double wordsTime = measure(iterationCount, [&]() {
+      BigInt created = rtExt->createBigIntFromWords(false, words.data(), words.size());
+      rtExt->getBigIntWords(created, &isNegative, result.data(), result.size());
+    });
+    double stringTime = measure(iterationCount, [&]() {
+      BigInt created = parseHex.call(rt, String::createFromAscii(rt, hex)).getBigInt(rt);
+      created.toString(rt, 16).utf8(rt);
+    });
+    EXPECT_EQ(result, words);
+
+    std::string bits = std::to_string(wordCount * 64);
+    report(("BigInt " + bits + "-bit round trip via words").c_str(), wordsTime);
+    report(("BigInt " + bits + "-bit round trip via hex string").c_str(), stringTime);
+  }
+}
+
+// Converts the struct fields one by one the same way as the hand-written code does.
+template <typename TStruct>
+struct HandWrittenStruct {
+  static Object toObject(Runtime &rt, const TStruct &value) {
+    Object obj(rt);
+    std::apply(
+        [&rt, &obj, &value](const auto &...field) { (obj.setProperty(rt, field.name, value.*field.member), ...); },
+        JsiStructFields<TStruct>::fields);
+    return obj;
+  }
+
+  static TStruct fromObject(Runtime &rt, const Object &obj) {
+    TStruct result{};
+    std::apply(
+        [&rt, &obj, &result](const auto &...field) {
+          ((result.*field.member = obj.getProperty(rt, field.name).getNumber()), ...);
+        },
+        JsiStructFields<TStruct>::fields);
+    return result;
+  }
+};
+
+template <size_t FieldCount>
+static void benchmarkStructMarshaling(Runtime &rt, size_t iterationCount) {
+  using TStruct = BenchmarkStructOf<FieldCount>;
+  TStruct value{};
+  std::string fieldCountText = std::to_string(FieldCount);
+
+  double handWrittenTime = NodeApiJsiBenchmark::measure(iterationCount, [&]() {
+    Object obj = HandWrittenStruct<TStruct>::toObject(rt, value);
+    TStruct result = HandWrittenStruct<TStruct>::fromObject(rt, obj);
+    EXPECT_EQ(static_cast<BenchmarkField<FieldCount - 1> &>(result).value, FieldCount - 1);
+  });
+  NodeApiJsiBenchmark::report(("Round trip " + fieldCountText + "-field struct by hand").c_str(), handWrittenTime);
+
+  double reflectedTime = NodeApiJsiBenchmark::measure(iterationCount, [&]() {
+    Object obj = JsiStruct<TStruct>::toObject(rt, value);
+    TStruct result = JsiStruct<TStruct>::fromObject(rt, obj);
+    EXPECT_EQ(static_cast<BenchmarkField<FieldCount - 1> &>(result).value, FieldCount - 1);
+  });
+  NodeApiJsiBenchmark::report(("Round trip " + fieldCountText + "-field struct with JsiStruct").c_str(), reflectedTime);
+}
+
+TEST_P(NodeApiJsiBenchmark, StructMarshaling) {
+  benchmarkStructMarshaling<5>(rt, 10000);
+  benchmarkStructMarshaling<20>(rt, 5000);
+  benchmarkStructMarshaling<100>(rt, 1000);
+}
+
+// Compares the Hermes runtime start with a cold and warm script cache for a generated bundle.
+TEST(HermesScriptCacheBenchmark, ColdAndWarmStart) {
+  std::string source;
+  for (int i = 0; i < 20000; ++i) {
+    std::string index = std::to_string(i);
+    source += "function f" + index + "(a, b) { return a * " + index + " + b.length; }\n";
+  }
+  source += "f19999(2, 'abc');\n";
+  auto sourceBuffer = std::make_shared<StringBuffer>(source);
+
+  std::filesystem::path directory =
+      std::filesystem::temp_directory_path() / ("HermesScriptCacheBenchmark-" + std::to_string(std::random_device{}()));
+  auto cache = std::make_shared<FileScriptCache>(directory, 256 * 1024 * 1024);
+  HermesApi *hermesApi = HermesApi::fromLib();
+  HermesApi::Scope apiScope(hermesApi);
+  auto runScript = [&]() {
+    hermes_config config{};
+    hermes_runtime runtime{};
+    napi_env env{};
+    hermesApi->hermes_create_config(&config);
+    setHermesScriptCache(hermesApi, config, cache);
+    hermesApi->hermes_create_runtime(config, &runtime);
+    hermesApi->hermes_get_node_api_env(runtime, &env);
+    std::unique_ptr<Runtime> jsiRuntime = makeNodeApiJsiRuntime(env, hermesApi, nullptr);
+    EXPECT_EQ(jsiRuntime->evaluateJavaScript(sourceBuffer, "bundle.js").getNumber(), 2 * 19999 + 3);
+    jsiRuntime.reset();
+    hermesApi->hermes_delete_runtime(runtime);
+    hermesApi->hermes_delete_config(config);
+  };
+
+  double coldTime = NodeApiJsiBenchmark::measure(5, [&]() {
+    cache->clear();
+    runScript();
+  });
+  double warmTime = NodeApiJsiBenchmark::measure(5, runScript);
+  EXPECT_GT(cache->getStats().hitCount, 0u);
+  NodeApiJsiBenchmark::report("Hermes start with cold script cache", coldTime);
+  NodeApiJsiBenchmark::report("Hermes start with warm script cache", warmTime);
+
+  std::error_code ec;
+  std::filesystem::remove_all(directory, ec);
+}
+
+// Compares the Hermes runtime start with the lazy and eager binding of the API function table.
+// Each iteration uses a new API instance to measure the first calls of the API functions.
+TEST(NodeApiBindingBenchmark, LazyAndEagerStartup) {
+  static LibFuncResolver funcResolver("hermes");
+  auto runScript = [&](ApiBindingMode bindingMode) {
+    auto hermesApi = std::make_unique<HermesApi>(&funcResolver, bindingMode);
+    EXPECT_TRUE(hermesApi->missingFuncs().empty());
+    HermesApi::Scope apiScope(hermesApi.get());
+    hermes_config config{};
+    hermes_runtime runtime{};
+    napi_env env{};
+    hermesApi->hermes_create_config(&config);
+    hermesApi->hermes_create_runtime(config, &runtime);
+    hermesApi->hermes_get_node_api_env(runtime, &env);
+    std::unique_ptr<Runtime> jsiRuntime = makeNodeApiJsiRuntime(env, hermesApi.get(), nullptr);
+    Value result = jsiRuntime->evaluateJavaScript(
+        std::make_shared<StringBuffer>("[1, 2, 3].map(x => ({ value: String(x) })).length"), "startup.js");
+    EXPECT_EQ(result.getNumber(), 3);
+    result = Value();
+    jsiRuntime.reset();
+    hermesApi->hermes_delete_runtime(runtime);
+    hermesApi->hermes_delete_config(config);
+  };
+
+  double lazyTime = NodeApiJsiBenchmark::measure(20, [&]() { runScript(ApiBindingMode::Lazy); });
+  double eagerTime = NodeApiJsiBenchmark::measure(20, [&]() { runScript(ApiBindingMode::Eager); });
+  double bindTime = NodeApiJsiBenchmark::measure(20, [&]() { HermesApi(&funcResolver, ApiBindingMode::Eager); });
+
+  // The prefetching resolver looks up all symbols once when it is created.
+  LibLoadOptions loadOptions;
+  loadOptions.bindNow = true;
+  std::unique_ptr<LibFuncResolver> prefetchResolver;
+  double prefetchTime = NodeApiJsiBenchmark::measure(1, [&]() {
+    prefetchResolver = std::make_unique<LibFuncResolver>("hermes", loadOptions, HermesApi::funcNames());
+  });
+  double prefetchedBindTime =
+      NodeApiJsiBenchmark::measure(20, [&]() { HermesApi(prefetchResolver.get(), ApiBindingMode::Eager); });
+
+  NodeApiJsiBenchmark::report("Hermes start with lazy API binding", lazyTime);
+  NodeApiJsiBenchmark::report("Hermes start with eager API binding", eagerTime);
+  NodeApiJsiBenchmark::report("Eager API binding", bindTime);
+  NodeApiJsiBenchmark::report("Symbol prefetch at library load", prefetchTime);
+  NodeApiJsiBenchmark::report("Eager API binding with prefetched symbols", prefetchedBindTime);
+}
+
+// Reports the N-API calls made by the common JSI operations and the profiling overhead.
+TEST(NodeApiProfilerBenchmark, JsiMethodCosts) {
+  static LibFuncResolver funcResolver("hermes");
+  HermesApi hermesApi(&funcResolver, ApiBindingMode::Eager);
+  HermesApi::Scope apiScope(&hermesApi);
+  hermes_config config{};
+  hermes_runtime runtime{};
+  napi_env env{};
+  hermesApi.hermes_create_config(&config);
+  hermesApi.hermes_create_runtime(config, &runtime);
+  hermesApi.hermes_get_node_api_env(runtime, &env);
+  std::unique_ptr<Runtime> jsiRuntime = makeNodeApiJsiRuntime(env, &hermesApi, nullptr);
+  {
+    Runtime &rt = *jsiRuntime;
+    rt.global().setProperty(
+        rt,
+        "nativeAdd",
+        Function::createFromHostFunction(
+            rt, PropNameID::forAscii(rt, "nativeAdd"), 2, [](Runtime &, const Value &, const Value *args, size_t) {
+              return Value(args[0].getNumber() + args[1].getNumber());
+            }));
+    Object obj = rt.evaluateJavaScript(std::make_shared<StringBuffer>("({ x: 1, y: 2 })"), "init.js").getObject(rt);
+    Function callNative =
+        rt.evaluateJavaScript(std::make_shared<StringBuffer>("(function (a) { return nativeAdd(a, 1); })"), "call.js")
+            .getObject(rt)
+            .getFunction(rt);
+    PropNameID x = PropNameID::forAscii(rt, "x");
+    auto runWorkload = [&]() {
+      double total{};
+      for (int i = 0; i < 1000; ++i) {
+        total += obj.getProperty(rt, x).getNumber();
+        total += callNative.call(rt, i).getNumber();
+      }
+      EXPECT_EQ(total, 1000 + 999 * 1000 / 2 + 1000);
+    };
+
+    double plainTime = NodeApiJsiBenchmark::measure(20, runWorkload);
+    std::string report;
+    double profiledTime{};
+    {
+      NodeApiProfiler profiler(&hermesApi);
+      profiledTime = NodeApiJsiBenchmark::measure(20, runWorkload);
+      report = profiler.getReport();
+      EXPECT_NE(profiler.getJsonReport().find("napi_get_property"), std::string::npos);
+    }
+    std::printf("%s", report.c_str());
+    NodeApiJsiBenchmark::report("Property reads and host calls", plainTime);
+    NodeApiJsiBenchmark::report("Profiled property reads and host calls", profiledTime);
+  }
+  jsiRuntime.reset();
+  hermesApi.hermes_delete_runtime(runtime);
+  hermesApi.hermes_delete_config(config);
+}
+
+// Reports the N-API calls that create the primitive values with and without the scope cache of the runtime.
+// The runtime caches the primitive values only while a runtime scope such as the jsi::Scope is open.
+TEST(NodeApiProfilerBenchmark, PrimitiveValueCacheCalls) {
+  constexpr size_t iterationCount = 1000;
+  static LibFuncResolver funcResolver("hermes");
+  HermesApi hermesApi(&funcResolver, ApiBindingMode::Eager);
+  HermesApi::Scope apiScope(&hermesApi);
+  hermes_config config{};
+  hermes_runtime runtime{};
+  napi_env env{};
+  hermesApi.hermes_create_config(&config);
+  hermesApi.hermes_create_runtime(config, &runtime);
+  hermesApi.hermes_get_node_api_env(runtime, &env);
+  std::unique_ptr<Runtime> jsiRuntime = makeNodeApiJsiRuntime(env, &hermesApi, nullptr);
+  {
+    Runtime &rt = *jsiRuntime;
+    auto source = std::make_shared<StringBuffer>(
+        "(function(a, b, c, d, e, f) { return (a === undefined) + (b === null) + c + !d + (e === 7) + (f === 0.5); })");
+    Function countPrimitives = rt.evaluateJavaScript(source, "primitives.js").getObject(rt).getFunction(rt);
+    auto runCalls = [&]() {
+      for (size_t i = 0; i < iterationCount; ++i) {
+        EXPECT_EQ(countPrimitives.call(rt, Value::undefined(), Value::null(), true, false, 7, 0.5).getNumber(), 6);
+      }
+    };
+    auto countCalls = [](const NodeApiProfiler &profiler, const char *funcName) {
+      for (const NodeApiFuncStats &stats : profiler.getFuncStats()) {
+        if (std::strcmp(stats.funcName, funcName) == 0) {
+          return stats.callCount;
+        }
+      }
+      return uint64_t{0};
+    };
+
+    NodeApiProfiler profiler(&hermesApi);
+    const char *funcNames[] = {
+        "napi_get_undefined", "napi_get_null", "napi_get_boolean", "napi_create_int32", "napi_create_double"};
+    runCalls();
+    std::vector<uint64_t> uncachedCounts;
+    for (const char *funcName : funcNames) {
+      uncachedCounts.push_back(countCalls(profiler, funcName));
+    }
+    profiler.reset();
+    {
+      Scope scope(rt);
+      runCalls();
+    }
+    for (size_t i = 0; i < std::size(funcNames); ++i) {
+      uint64_t cachedCount = countCalls(profiler, funcNames[i]);
+      EXPECT_LE(cachedCount, uncachedCounts[i]);
+      NodeApiJsiBenchmark::reportCount(
+          (std::string(funcNames[i]) + " calls without scope cache").c_str(), uncachedCounts[i]);
+      NodeApiJsiBenchmark::reportCount((std::string(funcNames[i]) + " calls with scope cache").c_str(), cachedCount);
+    }
+    EXPECT_LT(countCalls(profiler, "napi_get_boolean"), uncachedCounts[2]);
+  }
+  jsiRuntime.reset();
+  hermesApi.hermes_delete_runtime(runtime);
+  hermesApi.hermes_delete_config(config);
+}
+
+// Compares repeated runs of the default prepared script implementation with napi_run_script.
+TEST(DefaultPreparedScriptBenchmark, RepeatedRuns) {
+  HermesApi *hermesApi = HermesApi::fromLib();
+  HermesApi::Scope apiScope(hermesApi);
+  hermes_config config{};
+  hermes_runtime runtime{};
+  napi_env env{};
+  hermesApi->hermes_create_config(&config);
+  hermesApi->hermes_create_runtime(config, &runtime);
+  hermesApi->hermes_get_node_api_env(runtime, &env);
+  napi_handle_scope outerScope{};
+  hermesApi->napi_open_handle_scope(env, &outerScope);
+
+  auto prepare = [&](std::string source) {
+    napi_ext_prepared_script script{};
+    auto buffer = new std::string(std::move(source));
+    EXPECT_EQ(
+        default_napi_ext_create_prepared_script(
+            env,
+            reinterpret_cast<uint8_t *>(buffer->data()),
+            buffer->size(),
+            [](napi_env /*env*/, void * /*data*/, void *hint) { delete static_cast<std::string *>(hint); },
+            buffer,
+            "template.js",
+            &script),
+        napi_ok);
+    return script;
+  };
+  auto run = [&](napi_ext_prepared_script script) {
+    napi_handle_scope scope{};
+    napi_value result{};
+    double value{};
+    hermesApi->napi_open_handle_scope(env, &scope);
+    EXPECT_EQ(default_napi_ext_prepared_script_run(env, script, &result), napi_ok);
+    hermesApi->napi_get_value_double(env, result, &value);
+    hermesApi->napi_close_handle_scope(env, scope);
+    return value;
+  };
+
+  // The script with declarations keeps them global.
+  napi_ext_prepared_script declarations = prepare("var declared = 5; declared * 2");
+  napi_ext_prepared_script commented = prepare("declared + 1 // comment at the end");
+  EXPECT_EQ(run(declarations), 10);
+  EXPECT_EQ(run(commented), 6);
+  EXPECT_EQ(run(commented), 6);
+  default_napi_ext_delete_prepared_script(env, declarations);
+  default_napi_ext_delete_prepared_script(env, commented);
+
+  // The script that closes the wrapping parenthesis early is a syntax error as it is for napi_run_script.
+  napi_ext_prepared_script unbalanced = prepare("1), (2");
+  napi_value unbalancedResult{}, error{};
+  EXPECT_EQ(default_napi_ext_prepared_script_run(env, unbalanced, &unbalancedResult), napi_pending_exception);
+  hermesApi->napi_get_and_clear_last_exception(env, &error);
+  default_napi_ext_delete_prepared_script(env, unbalanced);
+
+  std::string source = "({";
+  for (int i = 0; i < 200; ++i) {
+    source += "a" + std::to_string(i) + ": " + std::to_string(i) + ", ";
+  }
+  source += "}).a199";
+  napi_value sourceValue{};
+  hermesApi->napi_create_string_utf8(env, source.data(), source.size(), &sourceValue);
+  napi_ext_prepared_script expression = prepare(source);
+  double total{};
+  double runScriptTime = NodeApiJsiBenchmark::measure(2000, [&]() {
+    napi_handle_scope scope{};
+    napi_value result{};
+    double value{};
+    hermesApi->napi_open_handle_scope(env, &scope);
+    hermesApi->napi_run_script(env, sourceValue, &result);
+    hermesApi->napi_get_value_double(env, result, &value);
+    hermesApi->napi_close_handle_scope(env, scope);
+    total += value;
+  });
+  double preparedTime = NodeApiJsiBenchmark::measure(2000, [&]() { total += run(expression); });
+  EXPECT_EQ(total, 199 * 4000);
+  NodeApiJsiBenchmark::report("Repeated napi_run_script", runScriptTime);
+  NodeApiJsiBenchmark::report("Repeated default prepared script run", preparedTime);
+
+  default_napi_ext_delete_prepared_script(env, expression);
+  hermesApi->napi_close_handle_scope(env, outerScope);
+  hermesApi->hermes_delete_runtime(runtime);
+  hermesApi->hermes_delete_config(config);
+}
+
+// Compares the same N-API call made through the thread-local NodeApi::current() and through a NodeApi pointer that
+// the caller keeps, as the runtime does with its NodeApi. The napi_get_reference_value is the call that resolves
+// the referenced jsi::Pointer values.
+TEST(NodeApiCurrentBenchmark, ThreadLocalLookup) {
+  constexpr size_t iterationCount = 1000000;
+  HermesApi *hermesApi = HermesApi::fromLib();
+  HermesApi::Scope apiScope(hermesApi);
+  hermes_config config{};
+  hermes_runtime runtime{};
+  napi_env env{};
+  hermesApi->hermes_create_config(&config);
+  hermesApi->hermes_create_runtime(config, &runtime);
+  hermesApi->hermes_get_node_api_env(runtime, &env);
+  napi_handle_scope outerScope{};
+  hermesApi->napi_open_handle_scope(env, &outerScope);
+
+  napi_value obj{}, value{};
+  napi_ref ref{};
+  hermesApi->napi_create_object(env, &obj);
+  hermesApi->napi_create_reference(env, obj, 1, &ref);
+  size_t resolvedCount{};
+  double currentTime = NodeApiJsiBenchmark::measure(iterationCount, [&]() {
+    resolvedCount += NodeApi::current()->napi_get_reference_value(env, ref, &value) == napi_ok;
+  });
+  NodeApi *nodeApi = hermesApi;
+  double pointerTime = NodeApiJsiBenchmark::measure(iterationCount, [&]() {
+    resolvedCount += nodeApi->napi_get_reference_value(env, ref, &value) == napi_ok;
+  });
+  EXPECT_EQ(resolvedCount, 2 * iterationCount);
+  NodeApiJsiBenchmark::report("napi_get_reference_value via NodeApi::current()", currentTime);
+  NodeApiJsiBenchmark::report("napi_get_reference_value via NodeApi pointer", pointerTime);
+
+  hermesApi->napi_delete_reference(env, ref);
+  hermesApi->napi_close_handle_scope(env, outerScope);
+  hermesApi->hermes_delete_runtime(runtime);
+  hermesApi->hermes_delete_config(config);
+}
+
+INSTANTIATE_TEST_SUITE_P(Runtimes, NodeApiJsiBenchmark, ::testing::ValuesIn(runtimeGenerators()));
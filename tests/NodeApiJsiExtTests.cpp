@@ -0,0 +1,639 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+// Tests for the INodeApiJsiRuntime extensions of the jsi::Runtime.
+
+#include <NodeApiJsiRuntime.h>
+#include <NodeApiJsiStruct.h>
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../jsi/test/testlib.h"
+
+using namespace facebook::jsi;
+using namespace Microsoft::NodeApiJsi;
+
+struct TestPoint {
+  double x;
+  double y;
+};
+
+struct TestShape {
+  std::string name;
+  int32_t sides;
+  bool filled;
+  TestPoint origin;
+};
+
+template <>
+struct Microsoft::NodeApiJsi::JsiStructFields<TestPoint> {
+  static constexpr auto fields =
+      std::make_tuple(jsiStructField("x", &TestPoint::x), jsiStructField("y", &TestPoint::y));
+};
+
+template <>
+struct Microsoft::NodeApiJsi::JsiStructFields<TestShape> {
+  static constexpr auto fields = std::make_tuple(
+      jsiStructField("name", &TestShape::name),
+      jsiStructField("sides", &TestShape::sides),
+      jsiStructField("filled", &TestShape::filled),
+      jsiStructField("origin", &TestShape::origin));
+};
+
+class NodeApiJsiExtTest : public JSITestBase {
+ public:
+  NodeApiJsiExtTest() : rtExt(*getNodeApiJsiRuntime(rt)) {}
+
+  INodeApiJsiRuntime &rtExt;
+};
+
+// A buffer with UTF-16 characters.
+class Utf16Buffer : public Buffer {
+ public:
+  explicit Utf16Buffer(std::u16string str) : str_(std::move(str)) {}
+
+  size_t size() const override {
+    return str_.size() * sizeof(char16_t);
+  }
+
+  const uint8_t *data() const override {
+    return reinterpret_cast<const uint8_t *>(str_.data());
+  }
+
+ private:
+  std::u16string str_;
+};
+
+TEST_P(NodeApiJsiExtTest, LazyPropertyIsCreatedOnFirstAccess) {
+  int32_t factoryCallCount = 0;
+  rtExt.defineLazyProperty(rt.global(), PropNameID::forAscii(rt, "lazyValue"), [&factoryCallCount](Runtime &) {
+    ++factoryCallCount;
+    return Value(42);
+  });
+  EXPECT_EQ(factoryCallCount, 0);
+  EXPECT_TRUE(eval("'lazyValue' in globalThis").getBool());
+  EXPECT_EQ(factoryCallCount, 0);
+
+  EXPECT_EQ(eval("lazyValue").getNumber(), 42);
+  EXPECT_EQ(eval("lazyValue").getNumber(), 42);
+  EXPECT_EQ(rt.global().getProperty(rt, "lazyValue").getNumber(), 42);
+  EXPECT_EQ(factoryCallCount, 1);
+
+  // After the first access the accessor is replaced with a writable data property.
+  EXPECT_TRUE(eval("Object.getOwnPropertyDescriptor(globalThis, 'lazyValue').writable").getBool());
+  EXPECT_TRUE(eval("Object.getOwnPropertyDescriptor(globalThis, 'lazyValue').enumerable").getBool());
+  EXPECT_TRUE(eval("Object.getOwnPropertyDescriptor(globalThis, 'lazyValue').configurable").getBool());
+  eval("lazyValue = 5");
+  EXPECT_EQ(eval("lazyValue").getNumber(), 5);
+  EXPECT_EQ(factoryCallCount, 1);
+}
+
+TEST_P(NodeApiJsiExtTest, LazyPropertyHostFunction) {
+  rtExt.defineLazyProperty(rt.global(), PropNameID::forAscii(rt, "lazyAdd"), [](Runtime &rt) {
+    return Function::createFromHostFunction(
+        rt, PropNameID::forAscii(rt, "lazyAdd"), 2, [](Runtime &, const Value &, const Value *args, size_t /*count*/) {
+          return Value(args[0].getNumber() + args[1].getNumber());
+        });
+  });
+  EXPECT_EQ(eval("lazyAdd(2, 3)").getNumber(), 5);
+  EXPECT_TRUE(rt.global().getPropertyAsFunction(rt, "lazyAdd").isHostFunction(rt));
+}
+
+TEST_P(NodeApiJsiExtTest, LazyPropertyAssignedBeforeAccess) {
+  int32_t factoryCallCount = 0;
+  Object obj(rt);
+  rtExt.defineLazyProperty(obj, PropNameID::forAscii(rt, "x"), [&factoryCallCount](Runtime &) {
+    ++factoryCallCount;
+    return Value(1);
+  });
+  rt.global().setProperty(rt, "obj", obj);
+  eval("obj.x = 7");
+  EXPECT_EQ(obj.getProperty(rt, "x").getNumber(), 7);
+  EXPECT_EQ(factoryCallCount, 0);
+}
+
+TEST_P(NodeApiJsiExtTest, LazyPropertyInherited) {
+  int32_t factoryCallCount = 0;
+  Object proto(rt);
+  rtExt.defineLazyProperty(proto, PropNameID::forAscii(rt, "x"), [&factoryCallCount](Runtime &) {
+    ++factoryCallCount;
+    return Value(3);
+  });
+  rt.global().setProperty(rt, "proto", proto);
+  EXPECT_EQ(eval("Object.create(proto).x").getNumber(), 3);
+  EXPECT_EQ(eval("proto.x").getNumber(), 3);
+  EXPECT_TRUE(eval("Object.getOwnPropertyDescriptor(proto, 'x').writable").getBool());
+  EXPECT_EQ(factoryCallCount, 1);
+}
+
+TEST_P(NodeApiJsiExtTest, LazyPropertyFactoryThrows) {
+  int32_t factoryCallCount = 0;
+  rtExt.defineLazyProperty(rt.global(), PropNameID::forAscii(rt, "lazyThrows"), [&factoryCallCount](Runtime &) {
+    if (++factoryCallCount == 1) {
+      throw std::runtime_error("Factory failed");
+    }
+    return Value(true);
+  });
+  EXPECT_THROW(eval("lazyThrows"), JSError);
+  // The factory is called again after a failure.
+  EXPECT_TRUE(eval("lazyThrows").getBool());
+  EXPECT_EQ(factoryCallCount, 2);
+}
+
+TEST_P(NodeApiJsiExtTest, PrimitiveValuesPassedToJS) {
+  Function isSame = function("function(value, expected) { return Object.is(value, eval(expected)); }");
+  EXPECT_TRUE(isSame.call(rt, Value::undefined(), "undefined").getBool());
+  EXPECT_TRUE(isSame.call(rt, Value::null(), "null").getBool());
+  EXPECT_TRUE(isSame.call(rt, true, "true").getBool());
+  EXPECT_TRUE(isSame.call(rt, false, "false").getBool());
+  EXPECT_TRUE(isSame.call(rt, 0, "0").getBool());
+  EXPECT_TRUE(isSame.call(rt, -0.0, "-0").getBool());
+  EXPECT_TRUE(isSame.call(rt, -128, "-128").getBool());
+  EXPECT_TRUE(isSame.call(rt, 1023, "1023").getBool());
+  EXPECT_TRUE(isSame.call(rt, 1024, "1024").getBool());
+  EXPECT_TRUE(isSame.call(rt, 2147483647, "2147483647").getBool());
+  EXPECT_TRUE(isSame.call(rt, 2147483648.0, "2147483648").getBool());
+  EXPECT_TRUE(isSame.call(rt, -2147483649.0, "-2147483649").getBool());
+  EXPECT_TRUE(isSame.call(rt, 0.5, "0.5").getBool());
+  EXPECT_TRUE(isSame.call(rt, std::nan(""), "NaN").getBool());
+
+  // Cached values must stay valid across nested scopes.
+  for (int32_t i = 0; i < 3; ++i) {
+    Scope outerScope(rt);
+    EXPECT_TRUE(isSame.call(rt, 5, "5").getBool());
+    {
+      Scope innerScope(rt);
+      EXPECT_TRUE(isSame.call(rt, 5, "5").getBool());
+      EXPECT_TRUE(isSame.call(rt, 6, "6").getBool());
+    }
+    EXPECT_TRUE(isSame.call(rt, 6, "6").getBool());
+  }
+}
+
+TEST_P(NodeApiJsiExtTest, BulkArrayElements) {
+  // Use more elements than one bulk operation chunk.
+  constexpr size_t count = 150;
+  Array arr(rt, count + 2);
+
+  std::vector<double> doubles(count);
+  for (size_t i = 0; i < count; ++i) {
+    doubles[i] = i + 0.5;
+  }
+  rtExt.setValuesAtIndex(arr, 1, doubles.data(), count);
+  EXPECT_TRUE(arr.getValueAtIndex(rt, 0).isUndefined());
+  EXPECT_EQ(arr.getValueAtIndex(rt, 1).getNumber(), 0.5);
+  EXPECT_EQ(arr.getValueAtIndex(rt, count).getNumber(), count - 0.5);
+  EXPECT_TRUE(arr.getValueAtIndex(rt, count + 1).isUndefined());
+  std::vector<double> doublesResult(count);
+  rtExt.getValuesAtIndex(arr, 1, doublesResult.data(), count);
+  EXPECT_EQ(doublesResult, doubles);
+
+  std::vector<int32_t> ints(count);
+  for (size_t i = 0; i < count; ++i) {
+    ints[i] = static_cast<int32_t>(i) * 1000 - 5000;
+  }
+  rtExt.setValuesAtIndex(arr, 2, ints.data(), count);
+  std::vector<int32_t> intsResult(count);
+  rtExt.getValuesAtIndex(arr, 2, intsResult.data(), count);
+  EXPECT_EQ(intsResult, ints);
+  EXPECT_EQ(arr.getValueAtIndex(rt, 1).getNumber(), 0.5);
+
+  std::vector<std::string> strings(count);
+  std::vector<std::string_view> stringViews(count);
+  for (size_t i = 0; i < count; ++i) {
+    strings[i] = "item\xE2\x82\xAC" + std::to_string(i);
+    stringViews[i] = strings[i];
+  }
+  rtExt.setValuesAtIndex(arr, 0, stringViews.data(), count);
+  std::vector<std::string> stringsResult(count);
+  rtExt.getValuesAtIndex(arr, 0, stringsResult.data(), count);
+  EXPECT_EQ(stringsResult, strings);
+
+  Value values[] = {Value::null(), Value(true), String::createFromAscii(rt, "abc"), Object(rt)};
+  rtExt.setValuesAtIndex(arr, 0, values, std::size(values));
+  Value valuesResult[std::size(values)];
+  rtExt.getValuesAtIndex(arr, 0, valuesResult, std::size(values));
+  EXPECT_TRUE(valuesResult[0].isNull());
+  EXPECT_TRUE(valuesResult[1].getBool());
+  EXPECT_EQ(valuesResult[2].getString(rt).utf8(rt), "abc");
+  EXPECT_TRUE(Value::strictEquals(rt, valuesResult[3], values[3]));
+
+  // Typed reads require the matching element types.
+  EXPECT_THROW(rtExt.getValuesAtIndex(arr, 0, doublesResult.data(), 2), JSINativeException);
+  EXPECT_THROW(rtExt.getValuesAtIndex(arr, 0, stringsResult.data(), 2), JSINativeException);
+}
+
+TEST_P(NodeApiJsiExtTest, BatchedProperties) {
+  PropNameID names[] = {
+      PropNameID::forAscii(rt, "a"),
+      PropNameID::forAscii(rt, "b"),
+      PropNameID::forAscii(rt, "c"),
+      PropNameID::forAscii(rt, "d")};
+  Value values[] = {Value(1), Value(true), String::createFromAscii(rt, "text"), Object(rt)};
+  Object obj(rt);
+  rtExt.setProperties(obj, names, values, std::size(names));
+  rt.global().setProperty(rt, "obj", obj);
+  EXPECT_EQ(eval("JSON.stringify(Object.keys(obj))").getString(rt).utf8(rt), "[\"a\",\"b\",\"c\",\"d\"]");
+  EXPECT_TRUE(eval("Object.getOwnPropertyDescriptor(obj, 'c').writable").getBool());
+  EXPECT_TRUE(eval("Object.getOwnPropertyDescriptor(obj, 'c').enumerable").getBool());
+  EXPECT_TRUE(eval("Object.getOwnPropertyDescriptor(obj, 'c').configurable").getBool());
+
+  Value result[std::size(names)];
+  rtExt.getProperties(obj, names, result, std::size(names));
+  EXPECT_EQ(result[0].getNumber(), 1);
+  EXPECT_TRUE(result[1].getBool());
+  EXPECT_EQ(result[2].getString(rt).utf8(rt), "text");
+  EXPECT_TRUE(Value::strictEquals(rt, result[3], values[3]));
+
+  // Getters and inherited properties are read as with jsi::Object::getProperty.
+  Object derived = eval("Object.create({a: 10}, {b: {get() { return 20; }}})").getObject(rt);
+  rtExt.getProperties(derived, names, result, std::size(names));
+  EXPECT_EQ(result[0].getNumber(), 10);
+  EXPECT_EQ(result[1].getNumber(), 20);
+  EXPECT_TRUE(result[2].isUndefined());
+}
+
+TEST_P(NodeApiJsiExtTest, StructMarshaling) {
+  TestShape shape{"triangle", 3, true, {1.5, -2}};
+  Object obj = JsiStruct<TestShape>::toObject(rt, shape);
+  rt.global().setProperty(rt, "shape", obj);
+  EXPECT_EQ(
+      eval("JSON.stringify(shape)").getString(rt).utf8(rt),
+      "{\"name\":\"triangle\",\"sides\":3,\"filled\":true,\"origin\":{\"x\":1.5,\"y\":-2}}");
+
+  TestShape result = JsiStruct<TestShape>::fromObject(
+      rt, eval("({name: 'square', sides: 4, filled: false, origin: {x: 0, y: 7}, extra: 1})").getObject(rt));
+  EXPECT_EQ(result.name, "square");
+  EXPECT_EQ(result.sides, 4);
+  EXPECT_FALSE(result.filled);
+  EXPECT_EQ(result.origin.x, 0);
+  EXPECT_EQ(result.origin.y, 7);
+
+}
+
+TEST_P(NodeApiJsiExtTest, CachedPropNameIDs) {
+  static constexpr const char *names[] = {"first", "second"};
+  const PropNameID *propNameIDs = rtExt.getCachedPropNameIDs(names, std::size(names));
+  EXPECT_EQ(propNameIDs, rtExt.getCachedPropNameIDs(names, std::size(names)));
+  EXPECT_EQ(propNameIDs[0].utf8(rt), "first");
+  EXPECT_EQ(propNameIDs[1].utf8(rt), "second");
+}
+
+TEST_P(NodeApiJsiExtTest, Utf8Access) {
+  // Cover the scratch buffer boundaries with multi-byte characters at the end.
+  for (size_t length : {0, 1, 250, 251, 252, 253, 254, 255, 256, 1000, 100000}) {
+    std::string expected(length, 'a');
+    expected += "\xE2\x82\xAC";
+    String str = String::createFromUtf8(rt, expected);
+    std::string result;
+    rtExt.withUtf8(str, [&result](std::string_view utf8) { result = utf8; });
+    EXPECT_EQ(result, expected);
+
+    std::vector<char> buffer(expected.size() + 1, 'x');
+    EXPECT_EQ(rtExt.copyUtf8(str, buffer.data(), expected.size() - 1), expected.size());
+    EXPECT_EQ(std::string(buffer.data(), buffer.size()), std::string(buffer.size(), 'x'));
+    EXPECT_EQ(rtExt.copyUtf8(str, buffer.data(), buffer.size()), expected.size());
+    EXPECT_EQ(std::string(buffer.data(), expected.size()), expected);
+    EXPECT_EQ(buffer.back(), 'x');
+  }
+
+  // Nested calls use their own buffers.
+  String outer = String::createFromAscii(rt, "outer");
+  String inner = String::createFromAscii(rt, "inner");
+  rtExt.withUtf8(outer, [&](std::string_view outerUtf8) {
+    rtExt.withUtf8(inner, [](std::string_view innerUtf8) { EXPECT_EQ(innerUtf8, "inner"); });
+    EXPECT_EQ(inner.utf8(rt), "inner");
+    EXPECT_EQ(outerUtf8, "outer");
+  });
+
+  PropNameID name = PropNameID::forUtf8(rt, "name\xC3\xA9");
+  rtExt.withUtf8(name, [](std::string_view utf8) { EXPECT_EQ(utf8, "name\xC3\xA9"); });
+  char nameBuffer[6];
+  EXPECT_EQ(rtExt.copyUtf8(name, nameBuffer, std::size(nameBuffer)), 6u);
+  EXPECT_EQ(std::string_view(nameBuffer, 6), "name\xC3\xA9");
+}
+
+TEST_P(NodeApiJsiExtTest, Utf8StringsWithAsciiPrefix) {
+  // ASCII strings are created as Latin-1 strings. Check that non-ASCII characters at any position of
+  // the vectorized ASCII scan keep the UTF-8 path.
+  for (size_t length = 1; length <= 70; ++length) {
+    std::string ascii(length, 'k');
+    EXPECT_EQ(String::createFromUtf8(rt, ascii).utf8(rt), ascii);
+    for (size_t i = 0; i < length; ++i) {
+      std::string utf8 = ascii;
+      utf8.replace(i, 1, "\xC3\xA9");
+      EXPECT_EQ(String::createFromUtf8(rt, utf8).utf8(rt), utf8);
+      EXPECT_EQ(PropNameID::forUtf8(rt, utf8).utf8(rt), utf8);
+    }
+  }
+  EXPECT_TRUE(PropNameID::compare(rt, PropNameID::forUtf8(rt, "key"), PropNameID::forAscii(rt, "key")));
+}
+
+TEST_P(NodeApiJsiExtTest, ExternalStrings) {
+  std::string asciiText(10000, 'a');
+  String ascii = rtExt.createExternalStringFromUtf8(std::make_shared<StringBuffer>(asciiText));
+  EXPECT_EQ(ascii.utf8(rt), asciiText);
+
+  std::string utf8Text = "caf\xC3\xA9";
+  String utf8 = rtExt.createExternalStringFromUtf8(std::make_shared<StringBuffer>(utf8Text));
+  EXPECT_EQ(utf8.utf8(rt), utf8Text);
+
+  String utf16 = rtExt.createExternalStringFromUtf16(std::make_shared<Utf16Buffer>(u"caf\u00E9 \u20AC"));
+  EXPECT_EQ(utf16.utf8(rt), "caf\xC3\xA9 \xE2\x82\xAC");
+
+  rt.global().setProperty(rt, "externalString", ascii);
+  EXPECT_EQ(eval("externalString.length").getNumber(), 10000);
+  EXPECT_TRUE(eval("externalString === 'a'.repeat(10000)").getBool());
+  EXPECT_THROW(rtExt.createExternalStringFromUtf8(nullptr), JSINativeException);
+}
+
+TEST_P(NodeApiJsiExtTest, Utf16Strings) {
+  std::u16string text = u"abc \u00E9\u20AC \U0001F600";
+  String str = rtExt.createStringFromUtf16(text.data(), text.size());
+  EXPECT_EQ(str.utf8(rt), "abc \xC3\xA9\xE2\x82\xAC \xF0\x9F\x98\x80");
+  EXPECT_EQ(rtExt.utf16(str), text);
+  EXPECT_EQ(rtExt.utf16(String::createFromUtf8(rt, "\xF0\x9F\x98\x80")), u"\U0001F600");
+
+  rt.global().setProperty(rt, "str", str);
+  EXPECT_EQ(eval("str.length").getNumber(), text.size());
+  EXPECT_TRUE(rtExt.utf16(rtExt.createStringFromUtf16(nullptr, 0)).empty());
+
+  // Lone surrogates are preserved.
+  std::u16string loneSurrogate = u"a";
+  loneSurrogate += char16_t(0xD800);
+  EXPECT_EQ(rtExt.utf16(rtExt.createStringFromUtf16(loneSurrogate.data(), loneSurrogate.size())), loneSurrogate);
+}
+
+TEST_P(NodeApiJsiExtTest, StringInternCache) {
+  // The cache is disabled by default.
+  String::createFromAscii(rt, "status");
+  String::createFromAscii(rt, "status");
+  INodeApiJsiRuntime::StringInternCacheStats stats = rtExt.getStringInternCacheStats();
+  EXPECT_EQ(stats.hitCount, 0);
+  EXPECT_EQ(stats.missCount, 0);
+
+  rtExt.enableStringInternCache(2, 16);
+  String ok1 = String::createFromAscii(rt, "ok");
+  String ok2 = String::createFromUtf8(rt, "ok");
+  EXPECT_TRUE(String::strictEquals(rt, ok1, ok2));
+  EXPECT_EQ(ok2.utf8(rt), "ok");
+  String::createFromUtf8(rt, "caf\xC3\xA9");
+  // Long strings are not cached.
+  String::createFromAscii(rt, "a long string that is not cached");
+  stats = rtExt.getStringInternCacheStats();
+  EXPECT_EQ(stats.hitCount, 1);
+  EXPECT_EQ(stats.missCount, 2);
+  EXPECT_EQ(stats.evictionCount, 0);
+  EXPECT_EQ(stats.entryCount, 2);
+
+  // The least recently used "caf\xC3\xA9" is evicted.
+  String::createFromAscii(rt, "ok");
+  String::createFromAscii(rt, "error");
+  stats = rtExt.getStringInternCacheStats();
+  EXPECT_EQ(stats.hitCount, 2);
+  EXPECT_EQ(stats.evictionCount, 1);
+  String::createFromAscii(rt, "ok");
+  EXPECT_EQ(rtExt.getStringInternCacheStats().hitCount, 3);
+
+  // Evicted strings stay valid.
+  EXPECT_EQ(ok1.utf8(rt), "ok");
+  rtExt.enableStringInternCache(0, 0);
+  EXPECT_EQ(rtExt.getStringInternCacheStats().entryCount, 0);
+  EXPECT_EQ(ok2.utf8(rt), "ok");
+}
+
+TEST_P(NodeApiJsiExtTest, PreparedScriptCache) {
+  auto evaluate = [this](const char *source, const char *sourceURL) {
+    return rt.evaluateJavaScript(std::make_shared<StringBuffer>(source), sourceURL).getNumber();
+  };
+  const char *increment = "globalThis.counter = (globalThis.counter || 0) + 1";
+
+  // The cache is disabled by default.
+  evaluate(increment, "increment.js");
+  EXPECT_EQ(rtExt.getPreparedScriptCacheStats().missCount, 0);
+
+  // Cached scripts run every time and return their completion values.
+  rtExt.enablePreparedScriptCache(2);
+  EXPECT_EQ(evaluate(increment, "increment.js"), 2);
+  EXPECT_EQ(evaluate(increment, "increment.js"), 3);
+  INodeApiJsiRuntime::PreparedScriptCacheStats stats = rtExt.getPreparedScriptCacheStats();
+  EXPECT_EQ(stats.hitCount, 1);
+  EXPECT_EQ(stats.missCount, 1);
+  EXPECT_EQ(stats.entryCount, 1);
+
+  // The source URL is a part of the key.
+  EXPECT_EQ(evaluate(increment, "other.js"), 4);
+  EXPECT_EQ(rtExt.getPreparedScriptCacheStats().missCount, 2);
+
+  // The least recently used "other.js" is evicted.
+  EXPECT_EQ(evaluate(increment, "increment.js"), 5);
+  EXPECT_EQ(evaluate("counter * 10", "increment.js"), 50);
+  stats = rtExt.getPreparedScriptCacheStats();
+  EXPECT_EQ(stats.hitCount, 2);
+  EXPECT_EQ(stats.missCount, 3);
+  EXPECT_EQ(stats.evictionCount, 1);
+  EXPECT_EQ(evaluate(increment, "increment.js"), 6);
+  EXPECT_EQ(rtExt.getPreparedScriptCacheStats().hitCount, 3);
+
+  rtExt.enablePreparedScriptCache(0);
+  EXPECT_EQ(rtExt.getPreparedScriptCacheStats().entryCount, 0);
+  EXPECT_EQ(evaluate(increment, "increment.js"), 7);
+}
+
+TEST_P(NodeApiJsiExtTest, PrepareJavaScriptAsync) {
+  // The dispatcher queues tasks that the test runs on the JS thread.
+  std::mutex mutex;
+  std::condition_variable taskAdded;
+  std::deque<std::function<void()>> tasks;
+  auto dispatcher = [&](std::function<void()> task) {
+    std::scoped_lock lock{mutex};
+    tasks.push_back(std::move(task));
+    taskAdded.notify_one();
+  };
+  auto prepare = [&](const char *source, std::shared_ptr<const PreparedJavaScript> &script, std::exception_ptr &error) {
+    bool isCompleted{};
+    rtExt.prepareJavaScriptAsync(
+        std::make_shared<StringBuffer>(source),
+        "async.js",
+        dispatcher,
+        [&](std::shared_ptr<const PreparedJavaScript> result, std::exception_ptr resultError) {
+          script = std::move(result);
+          error = std::move(resultError);
+          isCompleted = true;
+        });
+    while (!isCompleted) {
+      std::unique_lock lock{mutex};
+      taskAdded.wait(lock, [&]() { return !tasks.empty(); });
+      std::function<void()> task = std::move(tasks.front());
+      tasks.pop_front();
+      lock.unlock();
+      task();
+    }
+  };
+
+  std::shared_ptr<const PreparedJavaScript> script;
+  std::exception_ptr error;
+  prepare("var asyncValue = 6; asyncValue * 7", script, error);
+  ASSERT_NE(script, nullptr);
+  EXPECT_EQ(error, nullptr);
+  EXPECT_EQ(rt.evaluatePreparedJavaScript(script).getNumber(), 42);
+  EXPECT_EQ(eval("asyncValue").getNumber(), 6);
+
+  // Engines may report syntax errors when the script is prepared or when it runs.
+  prepare("var = ;", script, error);
+  if (error != nullptr) {
+    EXPECT_EQ(script, nullptr);
+  } else {
+    EXPECT_THROW(rt.evaluatePreparedJavaScript(script), JSIException);
+  }
+}
+
+TEST_P(NodeApiJsiExtTest, BigIntToStringMatchesJS) {
+  // Compare with BigInt.prototype.toString for values of different sizes, including the ones that use
+  // the divide-and-conquer conversion, and for all radixes.
+  Function makeBigInt = function(
+      "function(bits, seed) {"
+      "  let value = 1n;"
+      "  for (let i = 1; i < bits; ++i) {"
+      "    seed = (seed * 48271) % 2147483647;"
+      "    value = (value << 1n) | BigInt(seed & 1);"
+      "  }"
+      "  return value;"
+      "}");
+  Function toString = function("function(value, radix) { return value.toString(radix); }");
+  Function negate = function("function(value) { return -value; }");
+  for (int32_t bits : {1, 32, 63, 64, 65, 127, 128, 1000, 2047, 2048, 2049, 5000, 20000}) {
+    BigInt positive = makeBigInt.call(rt, bits, bits).getBigInt(rt);
+    BigInt negative = negate.call(rt, positive).getBigInt(rt);
+    for (int32_t radix = 2; radix <= 36; ++radix) {
+      if (bits > 2049 && radix != 10 && radix != 16 && radix != 7) {
+        continue;
+      }
+      EXPECT_EQ(positive.toString(rt, radix).utf8(rt), toString.call(rt, positive, radix).getString(rt).utf8(rt))
+          << "bits: " << bits << ", radix: " << radix;
+      EXPECT_EQ(negative.toString(rt, radix).utf8(rt), toString.call(rt, negative, radix).getString(rt).utf8(rt))
+          << "bits: " << bits << ", radix: " << radix;
+    }
+  }
+
+  // Powers of the radix have zero chunks.
+  BigInt power = eval("10n ** 3000n").getBigInt(rt);
+  EXPECT_EQ(power.toString(rt, 10).utf8(rt), "1" + std::string(3000, '0'));
+  EXPECT_EQ(eval("-(2n ** 64n)").getBigInt(rt).toString(rt, 16).utf8(rt), "-10000000000000000");
+}
+
+TEST_P(NodeApiJsiExtTest, BigIntWords) {
+  Function isSame = function("function(value, expected) { return value === eval(expected); }");
+  const uint64_t words[] = {0x0123456789abcdefull, 0xfedcba9876543210ull, 1};
+  EXPECT_TRUE(isSame.call(rt, rtExt.createBigIntFromWords(false, words, 3), "0x1fedcba98765432100123456789abcdefn")
+                  .getBool());
+  EXPECT_TRUE(isSame.call(rt, rtExt.createBigIntFromWords(true, words, 2), "-0xfedcba98765432100123456789abcdefn")
+                  .getBool());
+  EXPECT_TRUE(isSame.call(rt, rtExt.createBigIntFromWords(true, nullptr, 0), "0n").getBool());
+
+  uint64_t result[3]{};
+  bool isNegative{};
+  BigInt negative = eval("-(2n ** 128n) - 5n").getBigInt(rt);
+  EXPECT_EQ(rtExt.getBigIntWords(negative, &isNegative, result, 3), 3u);
+  EXPECT_TRUE(isNegative);
+  EXPECT_EQ(result[0], 5u);
+  EXPECT_EQ(result[1], 0u);
+  EXPECT_EQ(result[2], 1u);
+
+  // The words are not changed if they do not fit.
+  uint64_t small[2]{7, 7};
+  EXPECT_EQ(rtExt.getBigIntWords(negative, nullptr, small, 2), 3u);
+  EXPECT_EQ(small[0], 7u);
+  EXPECT_EQ(small[1], 7u);
+
+  EXPECT_EQ(rtExt.getBigIntWords(eval("-(2n ** 64n)").getBigInt(rt), &isNegative, result, 3), 2u);
+  EXPECT_TRUE(isNegative);
+  EXPECT_EQ(result[0], 0u);
+  EXPECT_EQ(result[1], 1u);
+  EXPECT_EQ(rtExt.getBigIntWords(eval("-1n").getBigInt(rt), &isNegative, result, 1), 1u);
+  EXPECT_TRUE(isNegative);
+  EXPECT_EQ(result[0], 1u);
+  EXPECT_EQ(rtExt.getBigIntWords(eval("0n").getBigInt(rt), &isNegative, nullptr, 0), 0u);
+  EXPECT_FALSE(isNegative);
+
+  // Round trip of a large value.
+  std::vector<uint64_t> largeWords(100);
+  for (size_t i = 0; i < largeWords.size(); ++i) {
+    largeWords[i] = (i + 1) * 0x9e3779b97f4a7c15ull;
+  }
+  BigInt large = rtExt.createBigIntFromWords(true, largeWords.data(), largeWords.size());
+  std::vector<uint64_t> largeResult(largeWords.size());
+  EXPECT_EQ(rtExt.getBigIntWords(large, &isNegative, largeResult.data(), largeResult.size()), largeWords.size());
+  EXPECT_TRUE(isNegative);
+  EXPECT_EQ(largeResult, largeWords);
+}
+
+TEST_P(NodeApiJsiExtTest, JSErrorMessage) {
+  Function throwError = function(
+      "function() {"
+      "  const error = new Error('unused');"
+      "  Object.defineProperty(error, 'message', { get() { return 'custom'; } });"
+      "  throw error;"
+      "}");
+
+  // The error passed back to JS keeps its identity and properties.
+  Function rethrow = Function::createFromHostFunction(
+      rt, PropNameID::forAscii(rt, "rethrow"), 0, [&](Runtime &rt, const Value &, const Value *, size_t) -> Value {
+        return throwError.call(rt);
+      });
+  EXPECT_EQ(function("function(rethrow) { try { rethrow(); } catch (e) { return e.message; } }")
+                .call(rt, rethrow)
+                .getString(rt)
+                .utf8(rt),
+            "custom");
+
+  try {
+    throwError.call(rt);
+    FAIL() << "Expected JSError";
+  } catch (const JSError &error) {
+    EXPECT_EQ(error.getMessage(), "custom");
+    EXPECT_NE(std::string(error.what()).find("custom"), std::string::npos);
+    EXPECT_FALSE(error.getStack().empty());
+  }
+}
+
+TEST_P(NodeApiJsiExtTest, TryMethods) {
+  Function divide = function("function(a, b) { if (b === 0) throw new RangeError('Division by zero'); return a / b; }");
+  JsiResult result = rtExt.tryCall(divide, Value::undefined(), std::array<Value, 2>{6, 3}.data(), 2);
+  ASSERT_TRUE(result.hasValue());
+  EXPECT_EQ(result.value().getNumber(), 2);
+
+  result = rtExt.tryCall(divide, Value::undefined(), std::array<Value, 2>{6, 0}.data(), 2);
+  ASSERT_FALSE(result);
+  EXPECT_EQ(result.error().getObject(rt).getProperty(rt, "message").getString(rt).utf8(rt), "Division by zero");
+  EXPECT_THROW(std::move(result).valueOrThrow(rt), JSError);
+
+  // The runtime stays usable after the captured exception.
+  EXPECT_EQ(eval("1 + 2").getNumber(), 3);
+
+  Object obj = eval("({ get failing() { throw 'getter error'; }, value: 5 })").getObject(rt);
+  result = rtExt.tryGetProperty(obj, PropNameID::forAscii(rt, "value"));
+  ASSERT_TRUE(result);
+  EXPECT_EQ(result.value().getNumber(), 5);
+  result = rtExt.tryGetProperty(obj, PropNameID::forAscii(rt, "failing"));
+  ASSERT_FALSE(result);
+  EXPECT_EQ(result.error().getString(rt).utf8(rt), "getter error");
+
+  result = rtExt.tryEvaluate(std::make_shared<StringBuffer>("[1, 2, 3].length"), "length.js");
+  ASSERT_TRUE(result);
+  EXPECT_EQ(result.value().getNumber(), 3);
+  result = rtExt.tryEvaluate(std::make_shared<StringBuffer>("throw new Error('Script error')"), "error.js");
+  ASSERT_FALSE(result);
+  EXPECT_TRUE(result.error().isObject());
+  result = rtExt.tryEvaluate(std::make_shared<StringBuffer>("1 +"), "syntax.js");
+  ASSERT_FALSE(result);
+  EXPECT_TRUE(result.error().isObject());
+}
+
+INSTANTIATE_TEST_SUITE_P(Runtimes, NodeApiJsiExtTest, ::testing::ValuesIn(runtimeGenerators()));
@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <NodeApiProfiler.h>
+#include <gtest/gtest.h>
+#include <jsi/jsi.h>
+#include <cstring>
+#include <string>
+
+using namespace Microsoft::NodeApiJsi;
+
+// The static link mode has no function table entries to profile.
+#ifndef NODE_API_JSI_STATIC_LINK
+
+namespace {
+
+napi_status NAPI_CDECL testGetUndefined(napi_env /*env*/, napi_value *result) {
+  *result = nullptr;
+  return napi_ok;
+}
+
+napi_status NAPI_CDECL testGetNull(napi_env /*env*/, napi_value * /*result*/) {
+  return napi_generic_failure;
+}
+
+void unusedFunc() {}
+
+// Resolves the napi_get_undefined and napi_get_null to the test functions and all other functions to a stub that
+// must not be called.
+class TestFuncResolver : public IFuncResolver {
+ public:
+  FuncPtr getFuncPtr(const char *funcName) override {
+    if (std::strcmp(funcName, "napi_get_undefined") == 0) {
+      return reinterpret_cast<FuncPtr>(&testGetUndefined);
+    }
+    if (std::strcmp(funcName, "napi_get_null") == 0) {
+      return reinterpret_cast<FuncPtr>(&testGetNull);
+    }
+    return reinterpret_cast<FuncPtr>(&unusedFunc);
+  }
+};
+
+} // namespace
+
+TEST(NodeApiProfilerTest, CountsAndAttributesCalls) {
+  TestFuncResolver resolver;
+  NodeApi api(&resolver, ApiBindingMode::Eager);
+  napi_value value{};
+  {
+    NodeApiProfiler profiler(&api);
+    EXPECT_EQ(NodeApiProfiler::active(), &profiler);
+    EXPECT_NE(api.napi_get_undefined, &testGetUndefined);
+
+    EXPECT_EQ(api.napi_get_undefined(nullptr, &value), napi_ok);
+    {
+      NodeApiProfiler::JsiMethodScope methodScope("getProperty");
+      EXPECT_EQ(api.napi_get_undefined(nullptr, &value), napi_ok);
+      EXPECT_EQ(api.napi_get_undefined(nullptr, &value), napi_ok);
+      EXPECT_EQ(api.napi_get_null(nullptr, &value), napi_generic_failure);
+    }
+
+    std::vector<NodeApiFuncStats> funcStats = profiler.getFuncStats();
+    ASSERT_EQ(funcStats.size(), 2u);
+    const NodeApiFuncStats &undefinedStats =
+        std::strcmp(funcStats[0].funcName, "napi_get_undefined") == 0 ? funcStats[0] : funcStats[1];
+    EXPECT_STREQ(undefinedStats.funcName, "napi_get_undefined");
+    EXPECT_EQ(undefinedStats.callCount, 3u);
+    EXPECT_GE(undefinedStats.totalNanoseconds, undefinedStats.maxNanoseconds);
+    ASSERT_EQ(undefinedStats.jsiMethods.size(), 2u);
+
+    std::vector<NodeApiJsiMethodStats> jsiMethodStats = profiler.getJsiMethodStats();
+    ASSERT_EQ(jsiMethodStats.size(), 2u);
+    EXPECT_EQ(jsiMethodStats[0].jsiMethod, "getProperty");
+    EXPECT_EQ(jsiMethodStats[0].callCount, 1u);
+    EXPECT_EQ(jsiMethodStats[0].napiCallCount, 3u);
+    EXPECT_EQ(jsiMethodStats[1].jsiMethod, "(none)");
+    EXPECT_EQ(jsiMethodStats[1].napiCallCount, 1u);
+
+    EXPECT_NE(profiler.getReport().find("napi_get_undefined"), std::string::npos);
+    std::string json = profiler.getJsonReport();
+    EXPECT_EQ(json.rfind(R"({"type":"NodeApiProfiler","version":1,)", 0), 0u);
+    EXPECT_NE(json.find(R"("name":"napi_get_null","callCount":1)"), std::string::npos);
+
+    profiler.reset();
+    EXPECT_TRUE(profiler.getFuncStats().empty());
+    EXPECT_TRUE(profiler.getJsiMethodStats().empty());
+  }
+  EXPECT_EQ(NodeApiProfiler::active(), nullptr);
+  EXPECT_EQ(api.napi_get_undefined, &testGetUndefined);
+  EXPECT_EQ(api.napi_get_null, &testGetNull);
+}
+
+TEST(NodeApiProfilerTest, RequiresEagerBindingAndSingleProfiler) {
+  TestFuncResolver resolver;
+  NodeApi lazyApi(&resolver);
+  EXPECT_THROW(NodeApiProfiler{&lazyApi}, facebook::jsi::JSINativeException);
+
+  NodeApi api(&resolver, ApiBindingMode::Eager);
+  NodeApiProfiler profiler(&api);
+  EXPECT_THROW(NodeApiProfiler{&api}, facebook::jsi::JSINativeException);
+  EXPECT_EQ(NodeApiProfiler::active(), &profiler);
+}
+
+#endif // !NODE_API_JSI_STATIC_LINK
@@ -0,0 +1,185 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <NodeApiScriptCompiler.h>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace facebook::jsi;
+using namespace Microsoft::NodeApiJsi;
+
+// The static link mode has no function table entries to replace with the test functions.
+#ifndef NODE_API_JSI_STATIC_LINK
+
+namespace {
+
+// The state of the test compile functions. The compiled script is a std::string with the source URL.
+struct TestCompilerState {
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::vector<std::string> compiledURLs;
+  std::vector<std::thread::id> compileThreads;
+  size_t liveScriptCount{};
+  size_t deleteCount{};
+  bool isBlockCompileStarted{};
+  bool isBlockCompileReleased{};
+} testState;
+
+// Fails the "fail.js" and waits in the "block.js" until the test releases it.
+napi_status NAPI_CDECL testCompileScript(
+    const uint8_t * /*script_data*/,
+    size_t /*script_length*/,
+    const char *source_url,
+    napi_ext_compiled_script *result) {
+  std::unique_lock lock{testState.mutex};
+  testState.compiledURLs.push_back(source_url);
+  testState.compileThreads.push_back(std::this_thread::get_id());
+  if (std::strcmp(source_url, "fail.js") == 0) {
+    return napi_generic_failure;
+  }
+  if (std::strcmp(source_url, "block.js") == 0) {
+    testState.isBlockCompileStarted = true;
+    testState.changed.notify_all();
+    testState.changed.wait(lock, []() { return testState.isBlockCompileReleased; });
+  }
+  ++testState.liveScriptCount;
+  *result = reinterpret_cast<napi_ext_compiled_script>(new std::string(source_url));
+  return napi_ok;
+}
+
+napi_status NAPI_CDECL testDeleteCompiledScript(napi_ext_compiled_script compiled_script) {
+  std::scoped_lock lock{testState.mutex};
+  --testState.liveScriptCount;
+  ++testState.deleteCount;
+  delete reinterpret_cast<std::string *>(compiled_script);
+  return napi_ok;
+}
+
+void unusedFunc() {}
+
+// Resolves the compiled script functions to the test functions and all other functions to a stub that must not be
+// called.
+class TestFuncResolver : public IFuncResolver {
+ public:
+  FuncPtr getFuncPtr(const char *funcName) override {
+    if (std::strcmp(funcName, "napi_ext_compile_script") == 0) {
+      return reinterpret_cast<FuncPtr>(&testCompileScript);
+    }
+    if (std::strcmp(funcName, "napi_ext_delete_compiled_script") == 0) {
+      return reinterpret_cast<FuncPtr>(&testDeleteCompiledScript);
+    }
+    return reinterpret_cast<FuncPtr>(&unusedFunc);
+  }
+};
+
+class NodeApiScriptCompilerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    std::scoped_lock lock{testState.mutex};
+    testState.compiledURLs.clear();
+    testState.compileThreads.clear();
+    testState.liveScriptCount = 0;
+    testState.deleteCount = 0;
+    testState.isBlockCompileStarted = false;
+    testState.isBlockCompileReleased = false;
+  }
+
+  // Queues the script and stores the compiled script passed to the callback.
+  void compile(const char *sourceURL) {
+    compiler->compileAsync(
+        std::make_shared<StringBuffer>("1 + 2"),
+        sourceURL,
+        [this](std::shared_ptr<NodeApiScriptCompiler::CompiledScript> script) {
+          std::scoped_lock lock{testState.mutex};
+          compiledScripts.push_back(std::move(script));
+          testState.changed.notify_all();
+        });
+  }
+
+  void waitForCompiledScripts(size_t count) {
+    std::unique_lock lock{testState.mutex};
+    testState.changed.wait(lock, [&]() { return compiledScripts.size() >= count; });
+  }
+
+  TestFuncResolver resolver;
+  NodeApi api{&resolver, ApiBindingMode::Eager};
+  std::vector<std::shared_ptr<NodeApiScriptCompiler::CompiledScript>> compiledScripts;
+  std::unique_ptr<NodeApiScriptCompiler> compiler{std::make_unique<NodeApiScriptCompiler>(&api)};
+};
+
+} // namespace
+
+TEST_F(NodeApiScriptCompilerTest, CompilesOnBackgroundThread) {
+  compile("first.js");
+  compile("fail.js");
+  compile("second.js");
+  waitForCompiledScripts(3);
+
+  // The scripts are compiled in order on one thread that is not the caller thread.
+  {
+    std::scoped_lock lock{testState.mutex};
+    EXPECT_EQ(testState.compiledURLs, (std::vector<std::string>{"first.js", "fail.js", "second.js"}));
+    ASSERT_EQ(testState.compileThreads.size(), 3u);
+    EXPECT_NE(testState.compileThreads[0], std::this_thread::get_id());
+    EXPECT_EQ(testState.compileThreads[1], testState.compileThreads[0]);
+    EXPECT_EQ(testState.compileThreads[2], testState.compileThreads[0]);
+  }
+
+  EXPECT_EQ(compiledScripts[0]->status(), napi_ok);
+  napi_ext_compiled_script released = compiledScripts[0]->release();
+  ASSERT_NE(released, nullptr);
+  EXPECT_EQ(*reinterpret_cast<std::string *>(released), "first.js");
+  EXPECT_EQ(compiledScripts[0]->release(), nullptr);
+  EXPECT_EQ(compiledScripts[1]->status(), napi_generic_failure);
+  EXPECT_EQ(compiledScripts[1]->release(), nullptr);
+
+  // The script that is not released is deleted with its owner.
+  compiledScripts.clear();
+  EXPECT_EQ(testState.deleteCount, 1u);
+  EXPECT_EQ(testState.liveScriptCount, 1u);
+
+  // The released script is not deleted by the compiler.
+  compiler.reset();
+  EXPECT_EQ(testState.deleteCount, 1u);
+  testDeleteCompiledScript(released);
+  EXPECT_EQ(testState.liveScriptCount, 0u);
+}
+
+TEST_F(NodeApiScriptCompilerTest, DeletionCancelsScripts) {
+  // The script compiled before the deletion is held like the task that is not dispatched yet.
+  compile("held.js");
+  waitForCompiledScripts(1);
+
+  // The deletion waits for the running compilation and skips the queued scripts.
+  compile("block.js");
+  compile("queued.js");
+  {
+    std::unique_lock lock{testState.mutex};
+    testState.changed.wait(lock, []() { return testState.isBlockCompileStarted; });
+  }
+  std::thread releaseBlock([]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::scoped_lock lock{testState.mutex};
+    testState.isBlockCompileReleased = true;
+    testState.changed.notify_all();
+  });
+  compiler.reset();
+  releaseBlock.join();
+
+  // All compiled scripts are deleted once while the NodeApi is alive, and the held script is not usable.
+  EXPECT_EQ(testState.liveScriptCount, 0u);
+  size_t deleteCount = testState.deleteCount;
+  ASSERT_FALSE(compiledScripts.empty());
+  EXPECT_EQ(compiledScripts[0]->status(), napi_ok);
+  EXPECT_EQ(compiledScripts[0]->release(), nullptr);
+  compiledScripts.clear();
+  EXPECT_EQ(testState.deleteCount, deleteCount);
+}
+
+#endif // !NODE_API_JSI_STATIC_LINK
@@ -0,0 +1,131 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <HermesApi.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace Microsoft::NodeApiJsi;
+
+// The static link mode binds the functions at compile time.
+#ifndef NODE_API_JSI_STATIC_LINK
+
+namespace {
+
+void fakeFunc() {}
+
+// Resolves all functions to the fakeFunc except for the missing ones.
+class FakeFuncResolver : public IFuncResolver {
+ public:
+  FakeFuncResolver(std::vector<std::string> missingFuncs) : missingFuncs_(std::move(missingFuncs)) {}
+
+  FuncPtr getFuncPtr(const char *funcName) override {
+    ++resolveCount;
+    if (std::find(missingFuncs_.begin(), missingFuncs_.end(), funcName) != missingFuncs_.end()) {
+      return nullptr;
+    }
+    return reinterpret_cast<FuncPtr>(&fakeFunc);
+  }
+
+  size_t resolveCount{};
+
+ private:
+  std::vector<std::string> missingFuncs_;
+};
+
+template <typename TFunc>
+bool isFakeFunc(TFunc func) {
+  return reinterpret_cast<void (*)()>(func) == &fakeFunc;
+}
+
+} // namespace
+
+TEST(NodeApiBindingTest, EagerBindingResolvesAllFuncs) {
+  FakeFuncResolver resolver({"napi_create_object", "napi_ext_get_elements", "hermes_create_runtime"});
+  HermesApi api(&resolver, ApiBindingMode::Eager);
+  EXPECT_EQ(api.bindingMode(), ApiBindingMode::Eager);
+  EXPECT_GT(resolver.resolveCount, 130u);
+
+  // Only the required functions are reported as missing.
+  ASSERT_EQ(api.missingFuncs().size(), 2u);
+  EXPECT_STREQ(api.missingFuncs()[0], "napi_create_object");
+  EXPECT_STREQ(api.missingFuncs()[1], "hermes_create_runtime");
+
+  EXPECT_TRUE(isFakeFunc(api.napi_create_string_utf8));
+  EXPECT_TRUE(isFakeFunc(api.hermes_delete_runtime));
+  EXPECT_TRUE(isFakeFunc(api.node_api_create_external_string_latin1));
+  EXPECT_EQ(api.napi_ext_get_elements, &default_napi_ext_get_elements);
+  EXPECT_TRUE(isFakeFunc(api.napi_ext_create_prepared_script));
+}
+
+TEST(NodeApiBindingTest, EagerBindingUsesAllDefaultPreparedScriptFuncs) {
+  FakeFuncResolver resolver({"napi_ext_prepared_script_run"});
+  NodeApi api(&resolver, ApiBindingMode::Eager);
+  EXPECT_TRUE(api.missingFuncs().empty());
+  EXPECT_EQ(api.napi_ext_create_prepared_script, &default_napi_ext_create_prepared_script);
+  EXPECT_EQ(api.napi_ext_prepared_script_run, &default_napi_ext_prepared_script_run);
+}
+
+TEST(NodeApiBindingTest, LazyBindingResolvesNothingUpfront) {
+  FakeFuncResolver resolver({"napi_create_object"});
+  NodeApi api(&resolver);
+  EXPECT_EQ(api.bindingMode(), ApiBindingMode::Lazy);
+  EXPECT_EQ(resolver.resolveCount, 0u);
+  EXPECT_TRUE(api.missingFuncs().empty());
+  EXPECT_FALSE(isFakeFunc(api.napi_create_string_utf8));
+}
+
+#endif // !NODE_API_JSI_STATIC_LINK
+
+#ifdef _WIN32
+#define TEST_LIB_NAME "kernel32"
+#define TEST_LIB_FUNC "GetTickCount"
+#elif defined(__APPLE__)
+#define TEST_LIB_NAME "/usr/lib/libSystem.B.dylib"
+#define TEST_LIB_FUNC "malloc"
+#else
+#define TEST_LIB_NAME "libm.so.6"
+#define TEST_LIB_FUNC "cos"
+#endif
+
+TEST(LibLoaderTest, LoadsLibAndFuncs) {
+  for (bool bindNow : {false, true}) {
+    LibLoadOptions options;
+    options.bindNow = bindNow;
+    options.searchPaths = {"/no/such/dir"};
+    LibHandle libHandle = LibLoader::loadLib(TEST_LIB_NAME, options);
+    ASSERT_NE(libHandle, nullptr);
+    EXPECT_NE(LibLoader::getFuncPtr(libHandle, TEST_LIB_FUNC), nullptr);
+    EXPECT_EQ(LibLoader::getFuncPtr(libHandle, "no_such_func"), nullptr);
+  }
+}
+
+TEST(LibLoaderTest, ReturnsNullForMissingLib) {
+  EXPECT_EQ(LibLoader::loadLib("no_such_lib"), nullptr);
+  LibFuncResolver resolver("no_such_lib");
+  EXPECT_EQ(resolver.getFuncPtr(TEST_LIB_FUNC), nullptr);
+}
+
+TEST(LibLoaderTest, PrefetchesFuncs) {
+  LibFuncResolver resolver(TEST_LIB_NAME, {}, {TEST_LIB_FUNC, "no_such_func"});
+  ASSERT_NE(resolver.libHandle(), nullptr);
+  FuncPtr func = LibLoader::getFuncPtr(resolver.libHandle(), TEST_LIB_FUNC);
+  EXPECT_NE(func, nullptr);
+  EXPECT_EQ(resolver.getFuncPtr(TEST_LIB_FUNC), func);
+  EXPECT_EQ(resolver.getFuncPtr("no_such_func"), nullptr);
+}
+
+TEST(LibLoaderTest, ListsAllFuncNames) {
+  const std::vector<const char *> &names = HermesApi::funcNames();
+  EXPECT_GT(names.size(), NodeApi::funcNames().size());
+  auto hasName = [&](const char *name) {
+    return std::any_of(names.begin(), names.end(), [&](const char *n) { return std::strcmp(n, name) == 0; });
+  };
+  EXPECT_TRUE(hasName("napi_create_object"));
+  EXPECT_TRUE(hasName("napi_ext_get_elements"));
+  EXPECT_TRUE(hasName("napi_ext_prepared_script_run"));
+  EXPECT_TRUE(hasName("hermes_create_runtime"));
+}